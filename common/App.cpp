@@ -307,11 +307,16 @@ void App::Run()
         glViewport(0, 0, display_w, display_h);
         glClearColor(ClearColor.x, ClearColor.y, ClearColor.z, ClearColor.w);
         glClear(GL_COLOR_BUFFER_BIT);
-        ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+        Render();
         glfwSwapBuffers(Window);
     }
 }
 
+void App::Render()
+{
+    ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+}
+
 ImVec2 App::GetWindowSize() const
 {
     int w, h;
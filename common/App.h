@@ -33,6 +33,8 @@ struct App
     virtual void Start() { }
     // Update, called once per frame.
     virtual void Update() { /*implement me*/ }
+    // Render, called once per frame after Update. Draws ImGui by default.
+    virtual void Render();
     // Runs the app.
     void Run();
     // Get window size
@@ -40,3 +40,47 @@ inline bool GetBranchName(const std::string &git_repo_path, std::string &branch_
     return result;
 }
 
+
+inline bool GetCommitHash(const std::string &git_repo_path, std::string &commit_hash)
+{
+    std::string git_path = git_repo_path + "/.git/";
+    size_t size = 0;
+    char *git_head = (char *)ImFileLoadToMemory((git_path + "HEAD").c_str(), "r", &size, 1);
+    if (git_head == NULL)
+        return false;
+    strtok(git_head, "\r\n");
+    std::string head = git_head;
+    IM_FREE(git_head);
+    const std::string prefix = "ref: ";
+    if (head.compare(0, prefix.size(), prefix) != 0)
+    {
+        // detached HEAD holds the hash itself
+        commit_hash = head;
+        return true;
+    }
+    const std::string ref = head.substr(prefix.size());
+    if (char *git_ref = (char *)ImFileLoadToMemory((git_path + ref).c_str(), "r", &size, 1))
+    {
+        strtok(git_ref, "\r\n");
+        commit_hash = git_ref;
+        IM_FREE(git_ref);
+        return true;
+    }
+    // refs may have been packed by git gc, lines are "<hash> <ref>"
+    bool result = false;
+    if (char *packed = (char *)ImFileLoadToMemory((git_path + "packed-refs").c_str(), "r", &size, 1))
+    {
+        for (char *line = strtok(packed, "\r\n"); line != NULL; line = strtok(NULL, "\r\n"))
+        {
+            const char *space = strchr(line, ' ');
+            if (space != NULL && ref == space + 1)
+            {
+                commit_hash.assign(line, space - line);
+                result = true;
+                break;
+            }
+        }
+        IM_FREE(packed);
+    }
+    return result;
+}
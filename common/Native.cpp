@@ -1,6 +1,7 @@
 #include "Native.h"
 #include <iostream>
 #include <algorithm>
+#include <cstdio>
 
 #ifdef _WIN32
 #include <pdh.h>
@@ -16,6 +17,9 @@
 #include <time.h>
 #include <unistd.h>
 #endif
+#ifdef __APPLE__
+#include <mach/mach.h>
+#endif
 
 #include <filesystem>
 namespace fs = std::filesystem;
@@ -161,6 +165,13 @@ void OpenEmail(const std::string& address, const std::string& subject) {
     ShellExecuteA(0, 0, str.c_str(), 0, 0, 5);
 }
 
+size_t GetResidentMemory() {
+    PROCESS_MEMORY_COUNTERS pmc;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc)))
+        return pmc.WorkingSetSize;
+    return 0;
+}
+
 #elif defined(__APPLE__)
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -207,6 +218,14 @@ void OpenEmail(const std::string& address, const std::string& subject) {
     system(command.c_str());
 }
 
+size_t GetResidentMemory() {
+    mach_task_basic_info_data_t info;
+    mach_msg_type_number_t      count = MACH_TASK_BASIC_INFO_COUNT;
+    if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, (task_info_t)&info, &count) == KERN_SUCCESS)
+        return (size_t)info.resident_size;
+    return 0;
+}
+
 #elif defined(__linux__)
 
 static int anErr = 0;
@@ -269,6 +288,17 @@ void OpenEmail(const std::string& address, const std::string& subject) {
                   << "\n";
 }
 
+size_t GetResidentMemory() {
+    // second field of statm is the resident set in pages
+    size_t size = 0, resident = 0;
+    FILE*  f    = fopen("/proc/self/statm", "r");
+    if (f == nullptr)
+        return 0;
+    int read = fscanf(f, "%zu %zu", &size, &resident);
+    fclose(f);
+    return read == 2 ? resident * (size_t)sysconf(_SC_PAGESIZE) : 0;
+}
+
 #endif
 
 // Links/Resources
@@ -52,4 +52,7 @@ bool OpenFile(const std::string& path);
 void OpenUrl(const std::string& url);
 
 /// Opens an external link to an email
-void OpenEmail(const std::string& address, const std::string& subject = "");
\ No newline at end of file
+void OpenEmail(const std::string& address, const std::string& subject = "");
+
+/// Returns the current resident set size (working set on Windows) of this process in bytes
+size_t GetResidentMemory();
@@ -7,58 +7,44 @@
 #include <implot_internal.h>
 #include <vector>
 #include <json.hpp>
-#include <iomanip>
 #include <imgui_stdlib.h>
+#include <imgui_impl_opengl3.h>
 #include <string>
 #include <chrono>
 #include <deque>
 #include <algorithm>
 #include "plot_line_inline.h"
+#include "plot_spec.h"
+#include "plot_line_pyramid.h"
+#include "plot_staging.h"
 #include "Profiler.h"
+#include "benchmark_compare.h"
+#include "benchmark_data.h"
+#include "benchmark_machine.h"
+#include "benchmark_gpu.h"
 
-using Clock = std::chrono::high_resolution_clock;
+using Clock = std::chrono::steady_clock;
 
-template <typename T>
-inline void ImLinearRegression(const T *x, const T *y, int count, T *mOut, T *bOut)
-{
-    T xbar = ImMean(x, count);
-    T ybar = ImMean(y, count);
-    T xbar2 = xbar * xbar;
-    T xbarybar = xbar * ybar;
-    T sigmax2 = 0;
-    T sigmaxy = 0;
-    T den = (T)(1.0 / count);
-    for (int i = 0; i < count; ++i)
-    {
-        sigmax2 += (x[i] * x[i] - xbar2) * den;
-        sigmaxy += (x[i] * y[i] - xbarybar) * den;
-    }
-    *mOut = sigmaxy / sigmax2;
-    *bOut = -xbar * *mOut + ybar;
-}
+static const char *kRunLog = "benchmark_runs.jsonl";
 
-inline void MakeFitLine(const float *x, const float *y, int count, ImVec2 line[2], float *m, float *b)
-{
-    ImLinearRegression(x, y, count, m, b);
-    line[0].x = x[0];
-    line[1].x = x[count - 1];
-    line[0].y = (*m) * line[0].x + (*b);
-    line[1].y = (*m) * line[1].x + (*b);
-}
+// Counts heap allocations made through ImGui::MemAlloc, i.e. by ImGui and ImPlot.
+static size_t g_alloc_count = 0;
+static void *CountingAlloc(size_t size, void *) { ++g_alloc_count; return malloc(size); }
+static void CountingFree(void *ptr, void *) { free(ptr); }
 
 struct ScopedProfiler
 {
-    ScopedProfiler(int &_val) : val(_val)
+    ScopedProfiler(double &_val) : val(_val)
     {
         t1 = Clock::now();
     }
     ~ScopedProfiler()
     {
         auto t2 = Clock::now();
-        val += (int)std::chrono::duration_cast<std::chrono::microseconds>(t2 - t1).count();
+        val += std::chrono::duration<double, std::micro>(t2 - t1).count();
     }
-    std::chrono::high_resolution_clock::time_point t1;
-    int &val;
+    Clock::time_point t1;
+    double &val;
 };
 
 enum BenchmarkType
@@ -74,7 +60,9 @@ enum BenchmarkType
 static const char *BenchmarkType_Names[] = {"int", "float", "double", "ImVec2", "ImPlotPoint"};
 static const char *BenchmarkType_Letter[] = {"i", "f", "d", "v", "p"};
 
-static constexpr int kMaxFrames = 60;
+static constexpr int kMaxFrames = 30;   // frames per trial
+static constexpr int kWarmupFrames = 10; // frames discarded after each step change
+static constexpr int kDefaultTrials = 5;
 static constexpr int kMaxElems = 500000;
 static constexpr int kMaxElemsItem = 5000; // 5000 1000 500  100
 static constexpr int kDataNoise = 2500;
@@ -83,6 +71,14 @@ static constexpr int kMaxSteps = 10;
 static const int kElemValues[] = {100, 500, 1000, 5000};
 static const char *kElemsStrings[] = {"100", "500", "1000", "5000"};
 
+// plot sizes, from a sparkline up to 4K (-1 fills the window)
+static const ImVec2 kPlotSizes[] = {{-1, -1}, {120, 24}, {320, 240}, {1280, 720}, {3840, 2160}};
+static const char *kPlotSizeStrings[] = {"Fill", "Spark", "320x240", "720p", "4K"};
+
+// zoom on x around the center of the data, 1000x leaves 0.1% of it visible
+static const double kZoomValues[] = {1, 10, 100, 1000};
+static const char *kZoomStrings[] = {"1x", "10x", "100x", "1000x"};
+
 template <typename T>
 struct BenchmarkDataScalar
 {
@@ -90,13 +86,11 @@ struct BenchmarkDataScalar
     {
         Xs = new T[kMaxElems];
         Ys = new T[kMaxElems];
-        for (int i = 0; i < kMaxElems; i += kMaxElemsItem) {
-            for (int j = 0; j < kMaxElemsItem; ++j)
-            {
-                Xs[i+j] = static_cast<T>(j);
-                Ys[i+j] = static_cast<T>(kMaxElems - i + RandomRange<float>(-kDataNoise, kDataNoise));
-            }
-        }
+        Generate(BenchmarkDataset_Noise);
+    }
+    void Generate(BenchmarkDataset set)
+    {
+        GenerateBenchmarkData(set, Xs, Ys, kMaxElems, kMaxElemsItem, kMaxElems, kDataNoise);
     }
     ~BenchmarkDataScalar()
     {
@@ -117,10 +111,16 @@ struct BenchmarkDataVector
     BenchmarkDataVector()
     {
         Vs = new T[kMaxElems];
+        Generate(BenchmarkDataset_Noise);
+    }
+    void Generate(BenchmarkDataset set)
+    {
+        std::vector<double> xs(kMaxElems), ys(kMaxElems);
+        GenerateBenchmarkData(set, xs.data(), ys.data(), kMaxElems, kMaxElemsItem, kMaxElems, kDataNoise);
         for (int i = 0; i < kMaxElems; ++i)
         {
-            Vs[i].x = RandomRange<float>(0.0f, (float)kMaxElems);
-            Vs[i].y = RandomRange<float>(0.0f, (float)kMaxElems);
+            Vs[i].x = xs[i];
+            Vs[i].y = ys[i];
         }
     }
     ~BenchmarkDataVector() { delete[] Vs; }
@@ -130,71 +130,11 @@ struct BenchmarkDataVector
 typedef BenchmarkDataVector<ImVec2> BenchmarkDataImVec2;
 typedef BenchmarkDataVector<ImPlotPoint> BenchmarkDataImPlotPoint;
 
-struct BenchmarkRecord
-{
-    BenchmarkRecord()
-    {
-        Elems.reserve(kMaxSteps + 1);
-        Call.reserve(kMaxSteps + 1);
-        Frame.reserve(kMaxSteps + 1);
-        Fps.reserve(kMaxSteps + 1);
-    }
-    void AddRecord(int elems, float call, float frame, float fps)
-    {
-        Elems.push_back((float)elems);
-        Call.push_back(call);
-        Frame.push_back(frame);
-        Fps.push_back(fps);
-    }
-    void FitData()
-    {
-        MakeFitLine(Elems.data(), Call.data(), Elems.size(), Call_Fit, &Call_M, &Call_B);
-        MakeFitLine(Elems.data(), Frame.data(), Elems.size(), Frame_Fit, &Frame_M, &Frame_B);
-    }
-    std::vector<float> Elems;
-
-    std::vector<float> Call;
-    ImVec2 Call_Fit[2];
-    float Call_M = 0;
-    float Call_B = 0;
-
-    std::vector<float> Frame;
-    ImVec2 Frame_Fit[2];
-    float Frame_M = 0;
-    float Frame_B = 0;
-
-    std::vector<float> Fps;
-};
-
-struct BenchmarkRecordCollection
-{
-    BenchmarkRecordCollection() : Col(RandomColor())
-    {
-    }
-    void SetColorFromString(std::string &name)
-    {
-        Col = ImGui::ColorConvertU32ToFloat4(ImHashStr(name.c_str()));
-        Col.w = 1.0f;
-        ImGui::ColorConvertRGBtoHSV(Col.x, Col.y, Col.z, Col.x, Col.y, Col.z);
-        Col.z = ImRemap(Col.z, 0.0f, 1.0f, 0.25f, 1.0f);
-        ImGui::ColorConvertHSVtoRGB(Col.x, Col.y, Col.z, Col.x, Col.y, Col.z);
-    }
-    ImVec4 Col;
-    std::vector<BenchmarkRecord> Records;
-};
-
-using json = nlohmann::json;
-
-NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(ImVec2, x, y);
-NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(ImVec4, x, y, z, w);
-NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(BenchmarkRecord, Elems, Call, Call_Fit, Call_M, Call_B, Frame, Frame_Fit, Frame_M, Frame_B, Fps);
-NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(BenchmarkRecordCollection, Col, Records);
-
 struct IBenchmark
 {
-    IBenchmark(std::string name) : name(name) {}
+    IBenchmark(std::string name, int max_elems = kMaxElems, bool vectors = true, int max_plots = 0) : name(name), max_elems(max_elems), vectors(vectors), max_plots(max_plots) {}
     virtual ~IBenchmark() {}
-    void RunInt(const BenchmarkDataInt &data, int items, int elems, int32_t &call_time)
+    void RunInt(const BenchmarkDataInt &data, int items, int elems, double &call_time)
     {
         srand(0);
         for (int i = 0; i < items; ++i)
@@ -204,14 +144,13 @@ struct IBenchmark
             ImGui::PushID(i);
             {
                 ScopedProfiler prof(call_time);
-                ImPlot::SetNextLineStyle(Col);
-                ImPlot::SetNextFillStyle(Col);
+                SetItemStyle(Col);
                 PlotInt("##item", &data.Xs[e], &data.Ys[e], elems);
             }
             ImGui::PopID();
         }
     }
-    void RunFloat(const BenchmarkDataFloat &data, int items, int elems, int32_t &call_time)
+    void RunFloat(const BenchmarkDataFloat &data, int items, int elems, double &call_time)
     {
         srand(0);
         for (int i = 0; i < items; ++i)
@@ -221,14 +160,13 @@ struct IBenchmark
             ImGui::PushID(i);
             {
                 ScopedProfiler prof(call_time);
-                ImPlot::SetNextLineStyle(Col);
-                ImPlot::SetNextFillStyle(Col);
+                SetItemStyle(Col);
                 PlotFloat("##item", &data.Xs[e], &data.Ys[e], elems);
             }
             ImGui::PopID();
         }
     }
-    void RunDouble(const BenchmarkDataDouble &data, int items, int elems, int32_t &call_time)
+    void RunDouble(const BenchmarkDataDouble &data, int items, int elems, double &call_time)
     {
         srand(0);
         for (int i = 0; i < items; ++i)
@@ -238,14 +176,13 @@ struct IBenchmark
             ImGui::PushID(i);
             {
                 ScopedProfiler prof(call_time);
-                ImPlot::SetNextLineStyle(Col);
-                ImPlot::SetNextFillStyle(Col);
+                SetItemStyle(Col);
                 PlotDouble("##item", &data.Xs[e], &data.Ys[e], elems);
             }
             ImGui::PopID();
         }
     }
-    void RunImVec2(const BenchmarkDataImVec2 &data, int items, int elems, int32_t &call_time)
+    void RunImVec2(const BenchmarkDataImVec2 &data, int items, int elems, double &call_time)
     {
         srand(0);
         for (int i = 0; i < items; ++i)
@@ -255,14 +192,13 @@ struct IBenchmark
             ImGui::PushID(i);
             {
                 ScopedProfiler prof(call_time);
-                ImPlot::SetNextLineStyle(Col);
-                ImPlot::SetNextFillStyle(Col);
+                SetItemStyle(Col);
                 PlotImVec2("##item", &data.Vs[e], elems);
             }
             ImGui::PopID();
         }
     }
-    void RunImPlotPoint(const BenchmarkDataImPlotPoint &data, int items, int elems, int32_t &call_time)
+    void RunImPlotPoint(const BenchmarkDataImPlotPoint &data, int items, int elems, double &call_time)
     {
         srand(0);
         for (int i = 0; i < items; ++i)
@@ -272,19 +208,27 @@ struct IBenchmark
             ImGui::PushID(i);
             {
                 ScopedProfiler prof(call_time);
-                ImPlot::SetNextLineStyle(Col);
-                ImPlot::SetNextFillStyle(Col);
+                SetItemStyle(Col);
                 PlotImPlotPoint("##item", &data.Vs[e], elems);
             }
             ImGui::PopID();
         }
     }
+    // applied before every item, inside the timed call
+    virtual void SetItemStyle(const ImVec4 &col)
+    {
+        ImPlot::SetNextLineStyle(col);
+        ImPlot::SetNextFillStyle(col);
+    }
     virtual void PlotInt(const char *name, int *xs, int *ys, int count) = 0;
     virtual void PlotFloat(const char *name, float *xs, float *ys, int count) = 0;
     virtual void PlotDouble(const char *name, double *xs, double *ys, int count) = 0;
     virtual void PlotImVec2(const char *name, ImVec2 *vs, int count) = 0;
     virtual void PlotImPlotPoint(const char *name, ImPlotPoint *vs, int count) = 0;
     const std::string name;
+    const int max_elems; // total elements drawn at the last step
+    const bool vectors;  // false if the item has no strided overload for ImVec2/ImPlotPoint
+    const int max_plots; // > 0 if every item is its own plot (see IBenchmarkLayout)
 };
 
 struct Benchmark_PlotLine : IBenchmark
@@ -347,26 +291,405 @@ struct Benchmark_PlotShaded : IBenchmark
     virtual void PlotImPlotPoint(const char *n, ImPlotPoint *vs, int k) override { ImPlot::PlotShaded(n, &vs[0].x, &vs[0].y, k, 0, 0, sizeof(ImPlotPoint)); }
 };
 
+struct Benchmark_PlotStairs : IBenchmark
+{
+    Benchmark_PlotStairs() : IBenchmark("Stairs") {}
+    virtual void PlotInt(const char *n, int *xs, int *ys, int k) override { ImPlot::PlotStairs(n, xs, ys, k); }
+    virtual void PlotFloat(const char *n, float *xs, float *ys, int k) override { ImPlot::PlotStairs(n, xs, ys, k); }
+    virtual void PlotDouble(const char *n, double *xs, double *ys, int k) override { ImPlot::PlotStairs(n, xs, ys, k); }
+    virtual void PlotImVec2(const char *n, ImVec2 *vs, int k) override { ImPlot::PlotStairs(n, &vs[0].x, &vs[0].y, k, 0, 0, sizeof(ImVec2)); }
+    virtual void PlotImPlotPoint(const char *n, ImPlotPoint *vs, int k) override { ImPlot::PlotStairs(n, &vs[0].x, &vs[0].y, k, 0, 0, sizeof(ImPlotPoint)); }
+};
+
+struct Benchmark_PlotStems : IBenchmark
+{
+    // stems hang from just below each item's band instead of from zero
+    Benchmark_PlotStems() : IBenchmark("Stems") {}
+    virtual void PlotInt(const char *n, int *xs, int *ys, int k) override { ImPlot::PlotStems(n, xs, ys, k, ys[0] - kDataNoise); }
+    virtual void PlotFloat(const char *n, float *xs, float *ys, int k) override { ImPlot::PlotStems(n, xs, ys, k, ys[0] - kDataNoise); }
+    virtual void PlotDouble(const char *n, double *xs, double *ys, int k) override { ImPlot::PlotStems(n, xs, ys, k, ys[0] - kDataNoise); }
+    virtual void PlotImVec2(const char *n, ImVec2 *vs, int k) override { ImPlot::PlotStems(n, &vs[0].x, &vs[0].y, k, vs[0].y - kDataNoise, 0, 0, sizeof(ImVec2)); }
+    virtual void PlotImPlotPoint(const char *n, ImPlotPoint *vs, int k) override { ImPlot::PlotStems(n, &vs[0].x, &vs[0].y, k, vs[0].y - kDataNoise, 0, 0, sizeof(ImPlotPoint)); }
+};
+
+struct Benchmark_PlotErrorBars : IBenchmark
+{
+    Benchmark_PlotErrorBars() : IBenchmark("ErrorBars") {}
+    template <typename T>
+    static const T *Errors(T err)
+    {
+        static std::vector<T> errs(kMaxElemsItem, err);
+        return errs.data();
+    }
+    virtual void PlotInt(const char *n, int *xs, int *ys, int k) override { ImPlot::PlotErrorBars(n, xs, ys, Errors<int>(kDataNoise / 4), k); }
+    virtual void PlotFloat(const char *n, float *xs, float *ys, int k) override { ImPlot::PlotErrorBars(n, xs, ys, Errors<float>(kDataNoise / 4), k); }
+    virtual void PlotDouble(const char *n, double *xs, double *ys, int k) override { ImPlot::PlotErrorBars(n, xs, ys, Errors<double>(kDataNoise / 4), k); }
+    virtual void PlotImVec2(const char *n, ImVec2 *vs, int k) override { ImPlot::PlotErrorBars(n, &vs[0].x, &vs[0].y, &Errors(ImVec2(kDataNoise / 4, kDataNoise / 4))->y, k, 0, 0, sizeof(ImVec2)); }
+    virtual void PlotImPlotPoint(const char *n, ImPlotPoint *vs, int k) override { ImPlot::PlotErrorBars(n, &vs[0].x, &vs[0].y, &Errors(ImPlotPoint(kDataNoise / 4, kDataNoise / 4))->y, k, 0, 0, sizeof(ImPlotPoint)); }
+};
+
+struct Benchmark_PlotDigital : IBenchmark
+{
+    Benchmark_PlotDigital() : IBenchmark("Digital") {}
+    virtual void PlotInt(const char *n, int *xs, int *ys, int k) override { ImPlot::PlotDigital(n, xs, ys, k); }
+    virtual void PlotFloat(const char *n, float *xs, float *ys, int k) override { ImPlot::PlotDigital(n, xs, ys, k); }
+    virtual void PlotDouble(const char *n, double *xs, double *ys, int k) override { ImPlot::PlotDigital(n, xs, ys, k); }
+    virtual void PlotImVec2(const char *n, ImVec2 *vs, int k) override { ImPlot::PlotDigital(n, &vs[0].x, &vs[0].y, k, 0, 0, sizeof(ImVec2)); }
+    virtual void PlotImPlotPoint(const char *n, ImPlotPoint *vs, int k) override { ImPlot::PlotDigital(n, &vs[0].x, &vs[0].y, k, 0, 0, sizeof(ImPlotPoint)); }
+};
+
+struct Benchmark_PlotInfLines : IBenchmark
+{
+    Benchmark_PlotInfLines() : IBenchmark("InfLines") {}
+    virtual void PlotInt(const char *n, int *xs, int *ys, int k) override { ImPlot::PlotInfLines(n, xs, k); }
+    virtual void PlotFloat(const char *n, float *xs, float *ys, int k) override { ImPlot::PlotInfLines(n, xs, k); }
+    virtual void PlotDouble(const char *n, double *xs, double *ys, int k) override { ImPlot::PlotInfLines(n, xs, k); }
+    virtual void PlotImVec2(const char *n, ImVec2 *vs, int k) override { ImPlot::PlotInfLines(n, &vs[0].x, k, 0, 0, sizeof(ImVec2)); }
+    virtual void PlotImPlotPoint(const char *n, ImPlotPoint *vs, int k) override { ImPlot::PlotInfLines(n, &vs[0].x, k, 0, 0, sizeof(ImPlotPoint)); }
+};
+
+struct Benchmark_PlotHistogram : IBenchmark
+{
+    // horizontal so that bins follow the item's Y band and counts stay on screen
+    Benchmark_PlotHistogram() : IBenchmark("Histogram", kMaxElems, false) {}
+    virtual void PlotInt(const char *n, int *xs, int *ys, int k) override { ImPlot::PlotHistogram(n, ys, k, ImPlotBin_Sturges, 1.0, ImPlotRange(), ImPlotHistogramFlags_Horizontal); }
+    virtual void PlotFloat(const char *n, float *xs, float *ys, int k) override { ImPlot::PlotHistogram(n, ys, k, ImPlotBin_Sturges, 1.0, ImPlotRange(), ImPlotHistogramFlags_Horizontal); }
+    virtual void PlotDouble(const char *n, double *xs, double *ys, int k) override { ImPlot::PlotHistogram(n, ys, k, ImPlotBin_Sturges, 1.0, ImPlotRange(), ImPlotHistogramFlags_Horizontal); }
+    virtual void PlotImVec2(const char *n, ImVec2 *vs, int k) override {}
+    virtual void PlotImPlotPoint(const char *n, ImPlotPoint *vs, int k) override {}
+};
+
+struct Benchmark_PlotHistogram2D : IBenchmark
+{
+    Benchmark_PlotHistogram2D() : IBenchmark("Histogram2D", kMaxElems, false) {}
+    virtual void PlotInt(const char *n, int *xs, int *ys, int k) override { ImPlot::PlotHistogram2D(n, xs, ys, k); }
+    virtual void PlotFloat(const char *n, float *xs, float *ys, int k) override { ImPlot::PlotHistogram2D(n, xs, ys, k); }
+    virtual void PlotDouble(const char *n, double *xs, double *ys, int k) override { ImPlot::PlotHistogram2D(n, xs, ys, k); }
+    virtual void PlotImVec2(const char *n, ImVec2 *vs, int k) override {}
+    virtual void PlotImPlotPoint(const char *n, ImPlotPoint *vs, int k) override {}
+};
+
+struct Benchmark_PlotHeatmap : IBenchmark
+{
+    // each item is a kHeatmapRows x (k / kHeatmapRows) heatmap covering the item's band
+    static constexpr int kHeatmapRows = 10;
+    Benchmark_PlotHeatmap() : IBenchmark("Heatmap", kMaxElems, false) {}
+    template <typename T>
+    static void Plot(const char *n, T *xs, T *ys, int k)
+    {
+        ImPlotPoint bmin(xs[0], ys[0] - kDataNoise);
+        ImPlotPoint bmax(xs[k - 1], ys[0] + kDataNoise);
+        ImPlot::PlotHeatmap(n, ys, kHeatmapRows, k / kHeatmapRows, 0, kMaxElems + kDataNoise, NULL, bmin, bmax);
+    }
+    virtual void PlotInt(const char *n, int *xs, int *ys, int k) override { Plot(n, xs, ys, k); }
+    virtual void PlotFloat(const char *n, float *xs, float *ys, int k) override { Plot(n, xs, ys, k); }
+    virtual void PlotDouble(const char *n, double *xs, double *ys, int k) override { Plot(n, xs, ys, k); }
+    virtual void PlotImVec2(const char *n, ImVec2 *vs, int k) override {}
+    virtual void PlotImPlotPoint(const char *n, ImPlotPoint *vs, int k) override {}
+};
+
+struct Benchmark_PlotPieChart : IBenchmark
+{
+    // elements are grouped into pies of kSlices slices placed along the item
+    static constexpr int kSlices = 8;
+    Benchmark_PlotPieChart() : IBenchmark("PieChart", kMaxElems / 10, false) {}
+    template <typename T>
+    static void Plot(const char *n, T *xs, T *ys, int k)
+    {
+        static const char *labels[kSlices] = {"##0", "##1", "##2", "##3", "##4", "##5", "##6", "##7"};
+        ImGui::PushID(n);
+        for (int i = 0; i + kSlices <= k; i += kSlices)
+            ImPlot::PlotPieChart(labels, &ys[i], kSlices, xs[i], ys[i], kDataNoise / 2, NULL);
+        ImGui::PopID();
+    }
+    virtual void PlotInt(const char *n, int *xs, int *ys, int k) override { Plot(n, xs, ys, k); }
+    virtual void PlotFloat(const char *n, float *xs, float *ys, int k) override { Plot(n, xs, ys, k); }
+    virtual void PlotDouble(const char *n, double *xs, double *ys, int k) override { Plot(n, xs, ys, k); }
+    virtual void PlotImVec2(const char *n, ImVec2 *vs, int k) override {}
+    virtual void PlotImPlotPoint(const char *n, ImPlotPoint *vs, int k) override {}
+};
+
+struct Benchmark_PlotImage : IBenchmark
+{
+    // one small image per element, textured with the font atlas
+    Benchmark_PlotImage() : IBenchmark("Image", kMaxElems / 10) {}
+    template <typename X, typename Y>
+    static void Plot(const char *n, const X &xs, const Y &ys, int k)
+    {
+        ImTextureID tex = ImGui::GetIO().Fonts->TexID;
+        for (int i = 0; i < k; ++i)
+            ImPlot::PlotImage(n, tex, ImPlotPoint(xs(i) - 5, ys(i) - kDataNoise / 10), ImPlotPoint(xs(i) + 5, ys(i) + kDataNoise / 10));
+    }
+    virtual void PlotInt(const char *n, int *xs, int *ys, int k) override { Plot(n, [=](int i) { return (double)xs[i]; }, [=](int i) { return (double)ys[i]; }, k); }
+    virtual void PlotFloat(const char *n, float *xs, float *ys, int k) override { Plot(n, [=](int i) { return (double)xs[i]; }, [=](int i) { return (double)ys[i]; }, k); }
+    virtual void PlotDouble(const char *n, double *xs, double *ys, int k) override { Plot(n, [=](int i) { return xs[i]; }, [=](int i) { return ys[i]; }, k); }
+    virtual void PlotImVec2(const char *n, ImVec2 *vs, int k) override { Plot(n, [=](int i) { return (double)vs[i].x; }, [=](int i) { return (double)vs[i].y; }, k); }
+    virtual void PlotImPlotPoint(const char *n, ImPlotPoint *vs, int k) override { Plot(n, [=](int i) { return vs[i].x; }, [=](int i) { return vs[i].y; }, k); }
+};
+
+struct Benchmark_PlotText : IBenchmark
+{
+    Benchmark_PlotText() : IBenchmark("Text", kMaxElems / 10) {}
+    virtual void PlotInt(const char *n, int *xs, int *ys, int k) override { for (int i = 0; i < k; ++i) ImPlot::PlotText("x", xs[i], ys[i]); }
+    virtual void PlotFloat(const char *n, float *xs, float *ys, int k) override { for (int i = 0; i < k; ++i) ImPlot::PlotText("x", xs[i], ys[i]); }
+    virtual void PlotDouble(const char *n, double *xs, double *ys, int k) override { for (int i = 0; i < k; ++i) ImPlot::PlotText("x", xs[i], ys[i]); }
+    virtual void PlotImVec2(const char *n, ImVec2 *vs, int k) override { for (int i = 0; i < k; ++i) ImPlot::PlotText("x", vs[i].x, vs[i].y); }
+    virtual void PlotImPlotPoint(const char *n, ImPlotPoint *vs, int k) override { for (int i = 0; i < k; ++i) ImPlot::PlotText("x", vs[i].x, vs[i].y); }
+};
+
+// Base for benchmarks of per-plot overhead. Every item is drawn in its own small
+// plot holding a few lines, and the plots are laid out in a grid sized for
+// max_plots so that plot size stays the same through the sweep.
+struct IBenchmarkLayout : IBenchmark
+{
+    static constexpr int kLines = 3;
+    IBenchmarkLayout(std::string name, int max_plots, ImPlotFlags flags, ImPlotAxisFlags axis_flags)
+        : IBenchmark(name, kMaxElems, true, max_plots), flags(flags), axis_flags(axis_flags) {}
+    virtual void BeginLayout()
+    {
+        const ImVec2 avail = ImGui::GetContentRegionAvail();
+        const ImVec2 spacing = ImGui::GetStyle().ItemSpacing;
+        cols = ImMax(1, (int)ceilf(sqrtf(max_plots * avail.x / avail.y)));
+        rows = (max_plots + cols - 1) / cols;
+        cell = ImVec2(ImFloor((avail.x - spacing.x * (cols - 1)) / cols), ImFloor((avail.y - spacing.y * (rows - 1)) / rows));
+        index = 0;
+    }
+    virtual void EndLayout() {}
+    virtual bool BeginCell(const char *n) = 0;
+    template <typename T>
+    void PlotCell(const char *n, const T *xs, const T *ys, int k, int stride = sizeof(T))
+    {
+        static const char *labels[kLines] = {"a", "b", "c"};
+        if (!BeginCell(n))
+            return;
+        ImPlot::SetupAxes(NULL, NULL, axis_flags, axis_flags);
+        ImPlot::SetupAxesLimits(0, kMaxElemsItem, ys[0] - 2 * kDataNoise, ys[0] + 2 * kDataNoise, ImGuiCond_Always);
+        const int sub = k / kLines;
+        for (int j = 0; j < kLines; ++j)
+        {
+            const size_t skip = (size_t)j * sub * stride;
+            ImPlot::PlotLine(labels[j], (const T *)((const char *)xs + skip), (const T *)((const char *)ys + skip), sub, 0, 0, stride);
+        }
+        ImPlot::EndPlot();
+    }
+    virtual void PlotInt(const char *n, int *xs, int *ys, int k) override { PlotCell(n, xs, ys, k); }
+    virtual void PlotFloat(const char *n, float *xs, float *ys, int k) override { PlotCell(n, xs, ys, k); }
+    virtual void PlotDouble(const char *n, double *xs, double *ys, int k) override { PlotCell(n, xs, ys, k); }
+    virtual void PlotImVec2(const char *n, ImVec2 *vs, int k) override { PlotCell(n, &vs[0].x, &vs[0].y, k, sizeof(ImVec2)); }
+    virtual void PlotImPlotPoint(const char *n, ImPlotPoint *vs, int k) override { PlotCell(n, &vs[0].x, &vs[0].y, k, sizeof(ImPlotPoint)); }
+    const ImPlotFlags flags;
+    const ImPlotAxisFlags axis_flags;
+    int rows = 1, cols = 1, index = 0;
+    ImVec2 cell;
+};
+
+struct Benchmark_Plots : IBenchmarkLayout
+{
+    // full plots with legend, grid and tick labels
+    Benchmark_Plots() : IBenchmarkLayout("Plots", 200, ImPlotFlags_None, ImPlotAxisFlags_None) {}
+    Benchmark_Plots(std::string name, ImPlotFlags flags, ImPlotAxisFlags axis_flags) : IBenchmarkLayout(name, 200, flags, axis_flags) {}
+    virtual bool BeginCell(const char *n) override
+    {
+        if (index++ % cols != 0)
+            ImGui::SameLine();
+        return ImPlot::BeginPlot(n, cell, flags);
+    }
+};
+
+struct Benchmark_PlotsBare : Benchmark_Plots
+{
+    // bare canvases, isolates BeginPlot/EndPlot from ticks and legends
+    Benchmark_PlotsBare() : Benchmark_Plots("PlotsBare", ImPlotFlags_CanvasOnly, ImPlotAxisFlags_NoDecorations) {}
+};
+
+struct Benchmark_Subplots : IBenchmarkLayout
+{
+    Benchmark_Subplots() : IBenchmarkLayout("Subplots", 200, ImPlotFlags_None, ImPlotAxisFlags_None) {}
+    virtual void BeginLayout() override
+    {
+        IBenchmarkLayout::BeginLayout();
+        open = ImPlot::BeginSubplots("##Subplots", rows, cols, ImGui::GetContentRegionAvail());
+    }
+    virtual void EndLayout() override
+    {
+        if (open)
+            ImPlot::EndSubplots();
+    }
+    virtual bool BeginCell(const char *n) override { return open && ImPlot::BeginPlot(n); }
+    bool open = false;
+};
+
 struct Benchmark_PlotLineInline : IBenchmark
 {
     Benchmark_PlotLineInline() : IBenchmark("LineInline") {}
     virtual void PlotInt(const char *n, int *xs, int *ys, int k) override { ImPlot::PlotLineInline(n, xs, ys, k); }
     virtual void PlotFloat(const char *n, float *xs, float *ys, int k) override { ImPlot::PlotLineInline(n, xs, ys, k); }
     virtual void PlotDouble(const char *n, double *xs, double *ys, int k) override { ImPlot::PlotLineInline(n, xs, ys, k); }
-    virtual void PlotImVec2(const char *n, ImVec2 *vs, int k) override {}
-    virtual void PlotImPlotPoint(const char *n, ImPlotPoint *vs, int k) override {}
+    virtual void PlotImVec2(const char *n, ImVec2 *vs, int k) override { ImPlot::PlotLineInline(n, vs, k); }
+    virtual void PlotImPlotPoint(const char *n, ImPlotPoint *vs, int k) override { ImPlot::PlotLineInline(n, vs, k); }
 };
 
+// LineInline without the AVX2 path, to measure what it gains
+struct Benchmark_PlotLineInlineScalar : IBenchmark
+{
+    Benchmark_PlotLineInlineScalar() : IBenchmark("LineInlineScalar") {}
+    virtual void PlotInt(const char *n, int *xs, int *ys, int k) override { ImPlot::PlotLineInline(n, xs, ys, k, ImPlotInlineFlags_NoSimd); }
+    virtual void PlotFloat(const char *n, float *xs, float *ys, int k) override { ImPlot::PlotLineInline(n, xs, ys, k, ImPlotInlineFlags_NoSimd); }
+    virtual void PlotDouble(const char *n, double *xs, double *ys, int k) override { ImPlot::PlotLineInline(n, xs, ys, k, ImPlotInlineFlags_NoSimd); }
+    virtual void PlotImVec2(const char *n, ImVec2 *vs, int k) override { ImPlot::PlotLineInline(n, vs, k, ImPlotInlineFlags_NoSimd); }
+    virtual void PlotImPlotPoint(const char *n, ImPlotPoint *vs, int k) override { ImPlot::PlotLineInline(n, vs, k, ImPlotInlineFlags_NoSimd); }
+};
+
+// LineInline told that x is sorted, so it only visits the visible slice; only
+// valid for datasets with monotonic x (not NonMonotonic)
+struct Benchmark_PlotLineInlineSorted : IBenchmark
+{
+    Benchmark_PlotLineInlineSorted() : IBenchmark("LineInlineSorted") {}
+    virtual void PlotInt(const char *n, int *xs, int *ys, int k) override { ImPlot::PlotLineInline(n, xs, ys, k, ImPlotInlineFlags_SortedX); }
+    virtual void PlotFloat(const char *n, float *xs, float *ys, int k) override { ImPlot::PlotLineInline(n, xs, ys, k, ImPlotInlineFlags_SortedX); }
+    virtual void PlotDouble(const char *n, double *xs, double *ys, int k) override { ImPlot::PlotLineInline(n, xs, ys, k, ImPlotInlineFlags_SortedX); }
+    virtual void PlotImVec2(const char *n, ImVec2 *vs, int k) override { ImPlot::PlotLineInline(n, vs, k, ImPlotInlineFlags_SortedX); }
+    virtual void PlotImPlotPoint(const char *n, ImPlotPoint *vs, int k) override { ImPlot::PlotLineInline(n, vs, k, ImPlotInlineFlags_SortedX); }
+};
+
+// Fast items built on the shared transform stage (plot_staging.h); compare each
+// with its standard item, e.g. ScatterStaged with Scatter
 struct Benchmark_PlotLineStaged : IBenchmark
 {
     Benchmark_PlotLineStaged() : IBenchmark("LineStaged") {}
     virtual void PlotInt(const char *n, int *xs, int *ys, int k) override { ImPlot::PlotLineStaged(n, xs, ys, k); }
     virtual void PlotFloat(const char *n, float *xs, float *ys, int k) override { ImPlot::PlotLineStaged(n, xs, ys, k); }
     virtual void PlotDouble(const char *n, double *xs, double *ys, int k) override { ImPlot::PlotLineStaged(n, xs, ys, k); }
+    virtual void PlotImVec2(const char *n, ImVec2 *vs, int k) override { ImPlot::PlotLineStaged(n, &vs[0].x, &vs[0].y, k, 0, sizeof(ImVec2)); }
+    virtual void PlotImPlotPoint(const char *n, ImPlotPoint *vs, int k) override { ImPlot::PlotLineStaged(n, &vs[0].x, &vs[0].y, k, 0, sizeof(ImPlotPoint)); }
+};
+
+struct Benchmark_PlotScatterStaged : IBenchmark
+{
+    Benchmark_PlotScatterStaged() : IBenchmark("ScatterStaged") {}
+    template <typename T>
+    static void Plot(const char *n, T *xs, T *ys, int k, int stride = sizeof(T))
+    {
+        ImPlot::SetNextMarkerStyle(ImPlotMarker_Square, 2);
+        ImPlot::PlotScatterStaged(n, xs, ys, k, 0, stride);
+    }
+    virtual void PlotInt(const char *n, int *xs, int *ys, int k) override { Plot(n, xs, ys, k); }
+    virtual void PlotFloat(const char *n, float *xs, float *ys, int k) override { Plot(n, xs, ys, k); }
+    virtual void PlotDouble(const char *n, double *xs, double *ys, int k) override { Plot(n, xs, ys, k); }
+    virtual void PlotImVec2(const char *n, ImVec2 *vs, int k) override { Plot(n, &vs[0].x, &vs[0].y, k, sizeof(ImVec2)); }
+    virtual void PlotImPlotPoint(const char *n, ImPlotPoint *vs, int k) override { Plot(n, &vs[0].x, &vs[0].y, k, sizeof(ImPlotPoint)); }
+};
+
+struct Benchmark_PlotBarsStaged : IBenchmark
+{
+    Benchmark_PlotBarsStaged() : IBenchmark("BarsStaged") {}
+    virtual void PlotInt(const char *n, int *xs, int *ys, int k) override { ImPlot::PlotBarsStaged(n, xs, ys, k, 0.8); }
+    virtual void PlotFloat(const char *n, float *xs, float *ys, int k) override { ImPlot::PlotBarsStaged(n, xs, ys, k, 0.8); }
+    virtual void PlotDouble(const char *n, double *xs, double *ys, int k) override { ImPlot::PlotBarsStaged(n, xs, ys, k, 0.8); }
+    virtual void PlotImVec2(const char *n, ImVec2 *vs, int k) override { ImPlot::PlotBarsStaged(n, &vs[0].x, &vs[0].y, k, 0.8, 0, sizeof(ImVec2)); }
+    virtual void PlotImPlotPoint(const char *n, ImPlotPoint *vs, int k) override { ImPlot::PlotBarsStaged(n, &vs[0].x, &vs[0].y, k, 0.8, 0, sizeof(ImPlotPoint)); }
+};
+
+struct Benchmark_PlotShadedStaged : IBenchmark
+{
+    Benchmark_PlotShadedStaged() : IBenchmark("ShadedStaged") {}
+    virtual void PlotInt(const char *n, int *xs, int *ys, int k) override { ImPlot::PlotShadedStaged(n, xs, ys, k); }
+    virtual void PlotFloat(const char *n, float *xs, float *ys, int k) override { ImPlot::PlotShadedStaged(n, xs, ys, k); }
+    virtual void PlotDouble(const char *n, double *xs, double *ys, int k) override { ImPlot::PlotShadedStaged(n, xs, ys, k); }
+    virtual void PlotImVec2(const char *n, ImVec2 *vs, int k) override { ImPlot::PlotShadedStaged(n, &vs[0].x, &vs[0].y, k, 0, 0, sizeof(ImVec2)); }
+    virtual void PlotImPlotPoint(const char *n, ImPlotPoint *vs, int k) override { ImPlot::PlotShadedStaged(n, &vs[0].x, &vs[0].y, k, 0, 0, sizeof(ImPlotPoint)); }
+};
+
+struct Benchmark_PlotStairsStaged : IBenchmark
+{
+    Benchmark_PlotStairsStaged() : IBenchmark("StairsStaged") {}
+    virtual void PlotInt(const char *n, int *xs, int *ys, int k) override { ImPlot::PlotStairsStaged(n, xs, ys, k); }
+    virtual void PlotFloat(const char *n, float *xs, float *ys, int k) override { ImPlot::PlotStairsStaged(n, xs, ys, k); }
+    virtual void PlotDouble(const char *n, double *xs, double *ys, int k) override { ImPlot::PlotStairsStaged(n, xs, ys, k); }
+    virtual void PlotImVec2(const char *n, ImVec2 *vs, int k) override { ImPlot::PlotStairsStaged(n, &vs[0].x, &vs[0].y, k, 0, sizeof(ImVec2)); }
+    virtual void PlotImPlotPoint(const char *n, ImPlotPoint *vs, int k) override { ImPlot::PlotStairsStaged(n, &vs[0].x, &vs[0].y, k, 0, sizeof(ImPlotPoint)); }
+};
+
+// LineStaged with M4 decimation, compare the Draw Lists memory plot for the
+// reduction in vertices
+struct Benchmark_PlotLineM4 : IBenchmark
+{
+    Benchmark_PlotLineM4() : IBenchmark("LineM4", kMaxElems, false) {}
+    virtual void PlotInt(const char *n, int *xs, int *ys, int k) override { ImPlot::PlotLineM4(n, xs, ys, k); }
+    virtual void PlotFloat(const char *n, float *xs, float *ys, int k) override { ImPlot::PlotLineM4(n, xs, ys, k); }
+    virtual void PlotDouble(const char *n, double *xs, double *ys, int k) override { ImPlot::PlotLineM4(n, xs, ys, k); }
+    virtual void PlotImVec2(const char *n, ImVec2 *vs, int k) override {}
+    virtual void PlotImPlotPoint(const char *n, ImPlotPoint *vs, int k) override {}
+};
+
+// Line drawn from a cached min/max pyramid, assuming evenly spaced x. The
+// pyramids are built on the first frame of a step, before warmup ends.
+struct Benchmark_PlotLinePyramid : IBenchmark
+{
+    Benchmark_PlotLinePyramid() : IBenchmark("LinePyramid", kMaxElems, false) {}
+    template <typename T>
+    static void Plot(const char *n, T *xs, T *ys, int k) { ImPlot::PlotLinePyramid(n, ys, k, k > 1 ? (double)(xs[1] - xs[0]) : 1.0, (double)xs[0]); }
+    virtual void PlotInt(const char *n, int *xs, int *ys, int k) override { Plot(n, xs, ys, k); }
+    virtual void PlotFloat(const char *n, float *xs, float *ys, int k) override { Plot(n, xs, ys, k); }
+    virtual void PlotDouble(const char *n, double *xs, double *ys, int k) override { Plot(n, xs, ys, k); }
     virtual void PlotImVec2(const char *n, ImVec2 *vs, int k) override {}
     virtual void PlotImPlotPoint(const char *n, ImPlotPoint *vs, int k) override {}
 };
 
+// Line styled with an inline ImPlotSpec instead of SetNextLineStyle/SetNextFillStyle.
+// Compare against Line with many small items to see the per item styling cost.
+struct Benchmark_PlotLineSpec : IBenchmark
+{
+    Benchmark_PlotLineSpec() : IBenchmark("LineSpec") {}
+    virtual void SetItemStyle(const ImVec4 &col) override { Col = col; }
+    virtual void PlotInt(const char *n, int *xs, int *ys, int k) override { ImPlot::PlotLine(n, xs, ys, k, ImPlotSpec_LineColor, Col, ImPlotSpec_FaceColor, Col); }
+    virtual void PlotFloat(const char *n, float *xs, float *ys, int k) override { ImPlot::PlotLine(n, xs, ys, k, ImPlotSpec_LineColor, Col, ImPlotSpec_FaceColor, Col); }
+    virtual void PlotDouble(const char *n, double *xs, double *ys, int k) override { ImPlot::PlotLine(n, xs, ys, k, ImPlotSpec_LineColor, Col, ImPlotSpec_FaceColor, Col); }
+    virtual void PlotImVec2(const char *n, ImVec2 *vs, int k) override { ImPlot::PlotLine(n, &vs[0].x, &vs[0].y, k, ImPlotSpec_LineColor, Col, ImPlotSpec_FaceColor, Col, ImPlotSpec_Stride, (int)sizeof(ImVec2)); }
+    virtual void PlotImPlotPoint(const char *n, ImPlotPoint *vs, int k) override { ImPlot::PlotLine(n, &vs[0].x, &vs[0].y, k, ImPlotSpec_LineColor, Col, ImPlotSpec_FaceColor, Col, ImPlotSpec_Stride, (int)sizeof(ImPlotPoint)); }
+    ImVec4 Col;
+};
+
+// Line with the data read through an ImPlotGetter callback, as the demos do for
+// computed data. Compare with Line to get the cost of the callback adapter.
+struct Benchmark_PlotLineGetter : IBenchmark
+{
+    Benchmark_PlotLineGetter() : IBenchmark("LineGetter") {}
+    template <typename T>
+    struct Arrays
+    {
+        static ImPlotPoint Getter(int idx, void *data)
+        {
+            auto &self = *(Arrays *)data;
+            return ImPlotPoint(self.xs[idx], self.ys[idx]);
+        }
+        const T *xs;
+        const T *ys;
+    };
+    template <typename T>
+    struct Vectors
+    {
+        static ImPlotPoint Getter(int idx, void *data) { return ImPlotPoint(((const T *)data)[idx].x, ((const T *)data)[idx].y); }
+    };
+    virtual void PlotInt(const char *n, int *xs, int *ys, int k) override { Arrays<int> a{xs, ys}; ImPlot::PlotLineG(n, Arrays<int>::Getter, &a, k); }
+    virtual void PlotFloat(const char *n, float *xs, float *ys, int k) override { Arrays<float> a{xs, ys}; ImPlot::PlotLineG(n, Arrays<float>::Getter, &a, k); }
+    virtual void PlotDouble(const char *n, double *xs, double *ys, int k) override { Arrays<double> a{xs, ys}; ImPlot::PlotLineG(n, Arrays<double>::Getter, &a, k); }
+    virtual void PlotImVec2(const char *n, ImVec2 *vs, int k) override { ImPlot::PlotLineG(n, Vectors<ImVec2>::Getter, vs, k); }
+    virtual void PlotImPlotPoint(const char *n, ImPlotPoint *vs, int k) override { ImPlot::PlotLineG(n, Vectors<ImPlotPoint>::Getter, vs, k); }
+};
+
+// Line with the start of the data at its middle (offset = count/2), i.e. a ring
+// buffer that has wrapped around, so every index goes through the modulo path.
+struct Benchmark_PlotLineOffset : IBenchmark
+{
+    Benchmark_PlotLineOffset() : IBenchmark("LineOffset") {}
+    virtual void PlotInt(const char *n, int *xs, int *ys, int k) override { ImPlot::PlotLine(n, xs, ys, k, 0, k / 2); }
+    virtual void PlotFloat(const char *n, float *xs, float *ys, int k) override { ImPlot::PlotLine(n, xs, ys, k, 0, k / 2); }
+    virtual void PlotDouble(const char *n, double *xs, double *ys, int k) override { ImPlot::PlotLine(n, xs, ys, k, 0, k / 2); }
+    virtual void PlotImVec2(const char *n, ImVec2 *vs, int k) override { ImPlot::PlotLine(n, &vs[0].x, &vs[0].y, k, 0, k / 2, sizeof(ImVec2)); }
+    virtual void PlotImPlotPoint(const char *n, ImPlotPoint *vs, int k) override { ImPlot::PlotLine(n, &vs[0].x, &vs[0].y, k, 0, k / 2, sizeof(ImPlotPoint)); }
+};
+
 struct BenchmarkRun
 {
     int benchmark;
@@ -374,14 +697,20 @@ struct BenchmarkRun
     int elems;
     bool aa;
     std::string name;
+    int dataset = BenchmarkDataset_Noise;
+    int size = 0;
+    int zoom = 0;
+    bool finish = false;
 };
 
 typedef std::deque<BenchmarkRun> BenchmarkQueue;
 
 struct ImPlotBench : App
 {
-    std::map<std::string, std::map<std::string, BenchmarkRecordCollection>> m_records;
+    BenchmarkRecordMap m_records;
+    BenchmarkMachine m_machine;
     std::string m_branch;
+    std::string m_group; // key of this session's results in m_records
     std::vector<std::unique_ptr<IBenchmark>> m_benchmarks;
 
     BenchmarkDataInt m_items_int;
@@ -389,48 +718,112 @@ struct ImPlotBench : App
     BenchmarkDataDouble m_items_double;
     BenchmarkDataImVec2 m_items_imvec2;
     BenchmarkDataImPlotPoint m_items_implot;
+    BenchmarkDataset m_dataset = BenchmarkDataset_Noise;
 
     BenchmarkQueue m_queue;
     std::map<std::string, BenchmarkQueue> m_queues;
 
+    // render timings, accumulated every frame by Render
+    BenchmarkGpuTimer m_gpu;
+    bool m_finish = false;
+    double m_submit = 0;
+    double m_upload = 0;
+    double m_draw = 0;
+    int m_gpu_frames = 0;
+
     ImPlotBench(int argc, char const *argv[]) : App("ImPlot Benchmark", 640, 480, argc, argv)
     {
     }
 
     ~ImPlotBench()
     {
-        json j;
-        j["records"] = m_records;
-        std::ofstream file("benchmark.json");
-        if (file.is_open())
-            file << std::setw(4) << j;
+        m_gpu.Shutdown();
     }
 
-    void Start() override
+    void Render() override
     {
-        std::ifstream file("benchmark.json");
-        if (file.is_open())
+        auto t1 = Clock::now();
+        m_gpu.StampNow(BenchmarkGpuTimer::Stamp_Begin);
+        ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+        m_gpu.StampNow(BenchmarkGpuTimer::Stamp_End);
+        // waits for the GPU, so submit time becomes end-to-end render time
+        if (m_finish)
+            glFinish();
+        auto t2 = Clock::now();
+        m_submit += std::chrono::duration<double, std::milli>(t2 - t1).count();
+        m_gpu.EndFrame(m_finish);
+        if (m_gpu.Ready)
         {
-            json j;
-            file >> j;
-            j.at("records").get_to(m_records);
+            m_upload += m_gpu.Upload;
+            m_draw += m_gpu.Draw;
+            m_gpu_frames++;
         }
+    }
 
-        GetBranchName("C:/git/implot/implot", m_branch);
+    void ResetRenderTimes()
+    {
+        m_submit = m_upload = m_draw = 0;
+        m_gpu_frames = 0;
+    }
+
+    void Start() override
+    {
+        // results from before the run log are still shown, but no longer written
+        LoadBenchmarkFile("benchmark.json", m_records);
+        LoadBenchmarkFile(kRunLog, m_records);
+
+        m_machine = GetBenchmarkMachine();
+        m_machine.Renderer = (const char *)glGetString(GL_RENDERER);
+        m_machine.GlVersion = (const char *)glGetString(GL_VERSION);
+        m_gpu.Init();
+        if (!m_gpu.Supported)
+            printf("GL timer queries not supported, upload and draw times will be zero\n");
+        if (!GetBranchName(IMPLOT_DIR, m_branch))
+            m_branch = m_machine.ImPlotCommit.substr(0, 8);
+        m_group = m_branch + "@" + m_machine.Host;
+        printf("%s on %s (%s, %d cores, %s)\n", m_branch.c_str(), m_machine.Host.c_str(), m_machine.Cpu.c_str(), m_machine.Cores, m_machine.Renderer.c_str());
 
         m_benchmarks.push_back(std::make_unique<Benchmark_PlotLine>());
         m_benchmarks.push_back(std::make_unique<Benchmark_PlotScatter>());
         m_benchmarks.push_back(std::make_unique<Benchmark_PlotBars>());
         m_benchmarks.push_back(std::make_unique<Benchmark_PlotShaded>());
+        m_benchmarks.push_back(std::make_unique<Benchmark_PlotStairs>());
+        m_benchmarks.push_back(std::make_unique<Benchmark_PlotStems>());
+        m_benchmarks.push_back(std::make_unique<Benchmark_PlotErrorBars>());
+        m_benchmarks.push_back(std::make_unique<Benchmark_PlotDigital>());
+        m_benchmarks.push_back(std::make_unique<Benchmark_PlotInfLines>());
+        m_benchmarks.push_back(std::make_unique<Benchmark_PlotHistogram>());
+        m_benchmarks.push_back(std::make_unique<Benchmark_PlotHistogram2D>());
+        m_benchmarks.push_back(std::make_unique<Benchmark_PlotHeatmap>());
+        m_benchmarks.push_back(std::make_unique<Benchmark_PlotPieChart>());
+        m_benchmarks.push_back(std::make_unique<Benchmark_PlotImage>());
+        m_benchmarks.push_back(std::make_unique<Benchmark_PlotText>());
+        m_benchmarks.push_back(std::make_unique<Benchmark_Plots>());
+        m_benchmarks.push_back(std::make_unique<Benchmark_PlotsBare>());
+        m_benchmarks.push_back(std::make_unique<Benchmark_Subplots>());
+        // standard items above, experimental implementations below
+        const int num_items = (int)m_benchmarks.size();
         m_benchmarks.push_back(std::make_unique<Benchmark_PlotLineInline>());
+        m_benchmarks.push_back(std::make_unique<Benchmark_PlotLineInlineScalar>());
+        m_benchmarks.push_back(std::make_unique<Benchmark_PlotLineInlineSorted>());
         m_benchmarks.push_back(std::make_unique<Benchmark_PlotLineStaged>());
-
-        m_queues["All Plots"] = {
-            {0, BenchmarkType_Double, 2, true},
-            {1, BenchmarkType_Double, 2, true},
-            {2, BenchmarkType_Double, 2, true},
-            {3, BenchmarkType_Double, 2, true},
-        };
+        m_benchmarks.push_back(std::make_unique<Benchmark_PlotScatterStaged>());
+        m_benchmarks.push_back(std::make_unique<Benchmark_PlotBarsStaged>());
+        m_benchmarks.push_back(std::make_unique<Benchmark_PlotShadedStaged>());
+        m_benchmarks.push_back(std::make_unique<Benchmark_PlotStairsStaged>());
+        m_benchmarks.push_back(std::make_unique<Benchmark_PlotLineM4>());
+        m_benchmarks.push_back(std::make_unique<Benchmark_PlotLinePyramid>());
+        m_benchmarks.push_back(std::make_unique<Benchmark_PlotLineSpec>());
+        m_benchmarks.push_back(std::make_unique<Benchmark_PlotLineGetter>());
+        m_benchmarks.push_back(std::make_unique<Benchmark_PlotLineOffset>());
+
+        const int line = FindBenchmark("Line");
+        const int line_inline = FindBenchmark("LineInline");
+
+        BenchmarkQueue all_plots;
+        for (int b = 0; b < num_items; ++b)
+            all_plots.push_back({b, BenchmarkType_Double, 2, true});
+        m_queues["All Plots"] = all_plots;
 
         m_queues["All Elems"] = {
             {0, BenchmarkType_Double, 0, true},
@@ -447,28 +840,167 @@ struct ImPlotBench : App
             {0, BenchmarkType_ImPlotPoint, 2, true},
         };
 
-        m_queues["Optimize"] = {
-            {0, BenchmarkType_Double, 2, true},
-            {4, BenchmarkType_Double, 2, true},
-            {0, BenchmarkType_Double, 2, true},
-            {4, BenchmarkType_Double, 2, true},
-            {0, BenchmarkType_Double, 2, true},
-            {4, BenchmarkType_Double, 2, true},
-            {0, BenchmarkType_Double, 2, true},
-            {4, BenchmarkType_Double, 2, true},
-            {0, BenchmarkType_Double, 2, true},
-            {4, BenchmarkType_Double, 2, true},
-        };
+        const int line_inline_scalar = FindBenchmark("LineInlineScalar");
+        BenchmarkQueue optimize;
+        for (int i = 0; i < 5; ++i) {
+            optimize.push_back({line, BenchmarkType_Double, 2, true});
+            optimize.push_back({line_inline_scalar, BenchmarkType_Double, 2, true});
+            optimize.push_back({line_inline, BenchmarkType_Double, 2, true});
+        }
+        m_queues["Optimize"] = optimize;
+
+        // separate arrays vs interleaved points of the same precision
+        BenchmarkQueue interleaved;
+        for (int b : {line, line_inline}) {
+            interleaved.push_back({b, BenchmarkType_Float, 2, true});
+            interleaved.push_back({b, BenchmarkType_ImVec2, 2, true});
+            interleaved.push_back({b, BenchmarkType_Double, 2, true});
+            interleaved.push_back({b, BenchmarkType_ImPlotPoint, 2, true});
+        }
+        m_queues["Interleaved"] = interleaved;
+
+        const int line_m4 = FindBenchmark("LineM4");
+        BenchmarkQueue decimate;
+        for (int e = 0; e < 4; ++e) {
+            decimate.push_back({line, BenchmarkType_Double, e, true});
+            decimate.push_back({line_m4, BenchmarkType_Double, e, true});
+            decimate.push_back({FindBenchmark("LinePyramid"), BenchmarkType_Double, e, true});
+        }
+        m_queues["Decimate"] = decimate;
+
+        // every staged item after its standard counterpart
+        BenchmarkQueue staged;
+        for (const char *item : {"Line", "Scatter", "Bars", "Shaded", "Stairs"}) {
+            staged.push_back({FindBenchmark(item), BenchmarkType_Double, 2, true});
+            staged.push_back({FindBenchmark(std::string(item) + "Staged"), BenchmarkType_Double, 2, true});
+            staged.push_back({FindBenchmark(std::string(item) + "Staged"), BenchmarkType_ImPlotPoint, 2, true});
+        }
+        m_queues["Staged"] = staged;
+
+        // 500K vertices or more per frame, well past one 16-bit draw command; run
+        // in a build with -DIMGUI_32BIT_INDICES=ON too and compare the two
+        BenchmarkQueue indices;
+        for (int e = 0; e < 4; ++e) {
+            indices.push_back({line, BenchmarkType_Double, e, true});
+            indices.push_back({line_inline, BenchmarkType_Double, e, true});
+            indices.push_back({FindBenchmark("LineStaged"), BenchmarkType_Double, e, true});
+        }
+        m_queues["Indices"] = indices;
+
+        // the fast line paths with and without the baked line texture; with AA
+        // all three draw 4 vertices per segment, so compare the plots by eye too
+        BenchmarkQueue aa_lines;
+        for (bool aa : {false, true}) {
+            aa_lines.push_back({line, BenchmarkType_Double, 2, aa});
+            aa_lines.push_back({line_inline, BenchmarkType_Double, 2, aa});
+            aa_lines.push_back({FindBenchmark("LineStaged"), BenchmarkType_Double, 2, aa});
+        }
+        m_queues["AA Lines"] = aa_lines;
+
+        // cost of breaking the fast line paths at NaN gaps, against gap free noise
+        BenchmarkQueue nan_gaps;
+        for (int d : {BenchmarkDataset_Noise, BenchmarkDataset_NaNGaps1, BenchmarkDataset_NaNGaps10, BenchmarkDataset_NaNGaps50}) {
+            nan_gaps.push_back({line, BenchmarkType_Double, 2, true, "", d});
+            nan_gaps.push_back({line_inline, BenchmarkType_Double, 2, true, "", d});
+            nan_gaps.push_back({line_inline_scalar, BenchmarkType_Double, 2, true, "", d});
+            nan_gaps.push_back({FindBenchmark("LineStaged"), BenchmarkType_Double, 2, true, "", d});
+        }
+        m_queues["NaN Gaps"] = nan_gaps;
+
+        // 5000 items of 100 points, where per item overhead dominates
+        const int line_spec = FindBenchmark("LineSpec");
+        BenchmarkQueue spec;
+        for (int i = 0; i < 5; ++i) {
+            spec.push_back({line, BenchmarkType_Double, 0, true});
+            spec.push_back({line_spec, BenchmarkType_Double, 0, true});
+        }
+        m_queues["Spec"] = spec;
+
+        // contiguous vs strided (ImPlotPoint) vs offset vs getter inputs
+        const int line_getter = FindBenchmark("LineGetter");
+        const int line_offset = FindBenchmark("LineOffset");
+        BenchmarkQueue adapters;
+        for (int e = 0; e < 4; ++e) {
+            adapters.push_back({line, BenchmarkType_Double, e, true});
+            adapters.push_back({line, BenchmarkType_ImPlotPoint, e, true});
+            adapters.push_back({line_offset, BenchmarkType_Double, e, true});
+            adapters.push_back({line_getter, BenchmarkType_Double, e, true});
+            adapters.push_back({line_getter, BenchmarkType_ImPlotPoint, e, true});
+        }
+        m_queues["Adapters"] = adapters;
 
         BenchmarkQueue everything;
-        for (int b = 0; b < 4; ++b) {
+        for (int b = 0; b < num_items; ++b) {
             for (int t = 0; t < 5; ++t) {
+                if (!m_benchmarks[b]->vectors && t >= BenchmarkType_ImVec2)
+                    continue;
                 for (int e = 0; e < 4; ++e) {
                     everything.push_back({b,t,e});
                 }
             }
         }
         m_queues["Everything"] = everything;
+
+        BenchmarkQueue all_data;
+        for (int d = 0; d < BenchmarkDataset_COUNT; ++d)
+            all_data.push_back({line, BenchmarkType_Double, 2, true, "", d});
+        m_queues["All Data"] = all_data;
+
+        BenchmarkQueue all_sizes;
+        for (int s = 0; s < IM_ARRAYSIZE(kPlotSizes); ++s)
+            all_sizes.push_back({line, BenchmarkType_Double, 2, true, "", BenchmarkDataset_Noise, s});
+        m_queues["All Sizes"] = all_sizes;
+
+        BenchmarkQueue all_zooms;
+        for (int z = 0; z < IM_ARRAYSIZE(kZoomValues); ++z)
+            all_zooms.push_back({line, BenchmarkType_Double, 2, true, "", BenchmarkDataset_Noise, 0, z});
+        m_queues["All Zooms"] = all_zooms;
+
+        BenchmarkQueue sorted_zooms;
+        for (int z = 0; z < IM_ARRAYSIZE(kZoomValues); ++z) {
+            sorted_zooms.push_back({line_inline, BenchmarkType_Double, 2, true, "", BenchmarkDataset_Noise, 0, z});
+            sorted_zooms.push_back({FindBenchmark("LineInlineSorted"), BenchmarkType_Double, 2, true, "", BenchmarkDataset_Noise, 0, z});
+        }
+        m_queues["Sorted Zooms"] = sorted_zooms;
+
+        m_queues["Layout"] = {
+            {FindBenchmark("Plots"), BenchmarkType_Double, 0, true},
+            {FindBenchmark("PlotsBare"), BenchmarkType_Double, 0, true},
+            {FindBenchmark("Subplots"), BenchmarkType_Double, 0, true},
+        };
+    }
+
+    void SetDataset(BenchmarkDataset set)
+    {
+        if (set == m_dataset)
+            return;
+        m_items_int.Generate(set);
+        m_items_float.Generate(set);
+        m_items_double.Generate(set);
+        m_items_imvec2.Generate(set);
+        m_items_implot.Generate(set);
+        // same buffers and sizes, new values
+        ImPlot::ClearPlotPyramids<int>();
+        ImPlot::ClearPlotPyramids<float>();
+        ImPlot::ClearPlotPyramids<double>();
+        m_dataset = set;
+    }
+
+    // number of items drawn at the last step
+    static int GetWorkingItems(const IBenchmark &bench, int elems)
+    {
+        const int items = bench.max_elems / elems;
+        return bench.max_plots > 0 ? ImMin(items, bench.max_plots) : items;
+    }
+
+    int FindBenchmark(const std::string &name) const
+    {
+        for (int i = 0; i < (int)m_benchmarks.size(); ++i)
+        {
+            if (m_benchmarks[i]->name == name)
+                return i;
+        }
+        return 0;
     }
 
     void Update() override
@@ -505,12 +1037,25 @@ struct ImPlotBench : App
         static int selected_type_idx = BenchmarkType_Double;
         static int selected_elems_idx = 2; // 1000
         static bool selected_aa = true;
+        static int num_trials = kDefaultTrials;
+        static int selected_data_idx = BenchmarkDataset_Noise;
+        static int selected_size_idx = 0;
+        static int selected_zoom_idx = 0;
+        static bool selected_finish = false;
 
         auto GetRunName = [&]()
         {
             auto str = m_benchmarks[selected_bench_idx]->name + "_" + BenchmarkType_Names[selected_type_idx] + "_" + kElemsStrings[selected_elems_idx];
+            if (selected_data_idx != BenchmarkDataset_Noise)
+                str += std::string("_") + BenchmarkDataset_Names[selected_data_idx];
+            if (selected_size_idx != 0)
+                str += std::string("_") + kPlotSizeStrings[selected_size_idx];
+            if (selected_zoom_idx != 0)
+                str += std::string("_z") + kZoomStrings[selected_zoom_idx];
             if (!selected_aa)
                 str += "_noaa";
+            if (selected_finish)
+                str += "_finish";
             if (this->UsingDGPU)
                 str += "_g";
             return str;
@@ -520,21 +1065,51 @@ struct ImPlotBench : App
         static BenchmarkRun working_run;
         static BenchmarkRecord working_record;
         static int working_elems = kElemValues[selected_elems_idx];
-        static int working_items = kMaxElems / working_elems;
+        static int working_items = GetWorkingItems(*m_benchmarks[selected_bench_idx], working_elems);
         static int working_add = working_items / kMaxSteps;
         static bool working_aa = true;
 
         static int current_items = 0;
         static int current_frame = 0;
+        static int current_trial = 0;
 
-        static int tcall = 0;
-        static int tother = 0;
+        static double tcall = 0;
+        static double tdraw = 0;
+        static size_t allocs0 = 0;
         static double t1 = 0;
         static double t2 = 0;
         static bool running = false;
 
-        static std::chrono::high_resolution_clock::time_point run_t1;
-        static std::chrono::high_resolution_clock::time_point run_t2;
+        static std::vector<float> trial_call;
+        static std::vector<float> trial_frame;
+        static std::vector<float> trial_fps;
+        static std::vector<float> trial_rss;
+        static size_t rss0 = 0;
+        static std::vector<float> trial_draw;
+        static std::vector<float> trial_allocs;
+        static std::vector<float> trial_submit;
+        static std::vector<float> trial_upload;
+        static std::vector<float> trial_gpu_draw;
+
+        static Clock::time_point run_t1;
+        static Clock::time_point run_t2;
+
+        auto ResetStep = [&]()
+        {
+            current_frame = current_trial = 0;
+            trial_call.clear();
+            trial_frame.clear();
+            trial_fps.clear();
+            trial_rss.clear();
+            trial_draw.clear();
+            trial_allocs.clear();
+            trial_submit.clear();
+            trial_upload.clear();
+            trial_gpu_draw.clear();
+            tcall = 0;
+            tdraw = 0;
+            ResetRenderTimes();
+        };
 
         auto StartNextRun = [&]()
         {
@@ -544,35 +1119,77 @@ struct ImPlotBench : App
             selected_bench_idx = working_run.benchmark;
             selected_elems_idx = working_run.elems;
             selected_aa = working_run.aa;
+            selected_data_idx = working_run.dataset;
+            SetDataset((BenchmarkDataset)selected_data_idx);
+            selected_size_idx = working_run.size;
+            selected_zoom_idx = working_run.zoom;
+            selected_finish = working_run.finish;
             if (working_run.name.empty())
                 working_run.name = GetRunName();
             working_name = working_run.name;
             working_record = BenchmarkRecord();
             working_elems = kElemValues[selected_elems_idx];
-            working_items = kMaxElems / working_elems;
+            working_items = GetWorkingItems(*m_benchmarks[selected_bench_idx], working_elems);
             working_add = working_items / kMaxSteps;
             working_aa = working_run.aa;
-            t1 = ImGui::GetTime();
-            current_items = current_frame = 0;
+            current_items = 0;
+            ResetStep();
+            // baseline for the resident set growth of every step in this run,
+            // taken after the dataset is generated so that it isn't counted
+            rss0 = GetResidentMemory();
         };
 
         if (running)
         {
+            // the first kWarmupFrames of every step are discarded so that buffer
+            // growth and cache effects from the previous step don't leak into it
             current_frame++;
-            if (current_frame == kMaxFrames)
+            if (current_frame == kWarmupFrames)
             {
-                t2 = ImGui::GetTime();
-                working_record.AddRecord(current_items * working_elems, (tcall / kMaxFrames) * 0.001f, 1000.0 * (t2 - t1) / kMaxFrames, kMaxFrames / (t2 - t1));
-                current_items += working_add;
-                current_frame = 0;
                 tcall = 0;
+                tdraw = 0;
+                allocs0 = g_alloc_count;
+                ResetRenderTimes();
                 t1 = ImGui::GetTime();
             }
+            else if (current_frame == kWarmupFrames + kMaxFrames)
+            {
+                t2 = ImGui::GetTime();
+                trial_call.push_back((float)(tcall / kMaxFrames * 0.001));
+                trial_frame.push_back((float)(1000.0 * (t2 - t1) / kMaxFrames));
+                trial_fps.push_back((float)(kMaxFrames / (t2 - t1)));
+                trial_rss.push_back((float)(((double)GetResidentMemory() - (double)rss0) / (1024.0 * 1024.0)));
+                trial_draw.push_back((float)(tdraw / kMaxFrames / 1024.0));
+                trial_allocs.push_back((float)(g_alloc_count - allocs0) / kMaxFrames);
+                trial_submit.push_back((float)(m_submit / kMaxFrames));
+                trial_upload.push_back((float)(m_gpu_frames > 0 ? m_upload / m_gpu_frames : 0));
+                trial_gpu_draw.push_back((float)(m_gpu_frames > 0 ? m_draw / m_gpu_frames : 0));
+                ResetRenderTimes();
+                tcall = 0;
+                tdraw = 0;
+                allocs0 = g_alloc_count;
+                t1 = t2;
+                current_frame = kWarmupFrames;
+                if (++current_trial == num_trials)
+                {
+                    working_record.AddRecord(current_items * working_elems, trial_call, trial_frame, trial_fps);
+                    working_record.AddMemory(trial_rss, trial_draw, trial_allocs);
+                    working_record.AddRender(trial_submit, trial_upload, trial_gpu_draw);
+                    current_items += working_add;
+                    ResetStep();
+                }
+            }
             if (current_items > working_items)
             {
                 working_record.FitData();
-                m_records[m_branch][working_name].Records.push_back(working_record);
-                m_records[m_branch][working_name].SetColorFromString(working_name);
+                BenchmarkRunRecord run;
+                run.Date = GetDateString();
+                run.Branch = m_branch;
+                run.Name = working_name;
+                run.Machine = m_machine;
+                run.Record = working_record;
+                AppendBenchmarkRun(kRunLog, run);
+                AddBenchmarkRun(m_records, run);
                 if (m_queue.size() > 0) {
                     StartNextRun();
                 }
@@ -599,6 +1216,8 @@ struct ImPlotBench : App
                 if (ImGui::Selectable(m_benchmarks[i]->name.c_str(), i == selected_bench_idx))
                 {
                     selected_bench_idx = i;
+                    if (!m_benchmarks[i]->vectors && selected_type_idx >= BenchmarkType_ImVec2)
+                        selected_type_idx = BenchmarkType_Double;
                     working_name = GetRunName();
                 }
             }
@@ -606,16 +1225,34 @@ struct ImPlotBench : App
         }
         ImGui::SameLine();
         ImGui::SetNextItemWidth(75);
-        if (ImGui::Combo("##Type", &selected_type_idx, BenchmarkType_Names, BenchmarkType_COUNT))
+        if (ImGui::Combo("##Type", &selected_type_idx, BenchmarkType_Names, m_benchmarks[selected_bench_idx]->vectors ? BenchmarkType_COUNT : BenchmarkType_ImVec2))
             working_name = GetRunName();
         ImGui::SameLine();
         ImGui::SetNextItemWidth(75);
         if (ImGui::Combo("##Elems", &selected_elems_idx, kElemsStrings, 4))
             working_name = GetRunName();
         ImGui::SameLine();
+        ImGui::SetNextItemWidth(100);
+        if (ImGui::Combo("##Data", &selected_data_idx, BenchmarkDataset_Names, BenchmarkDataset_COUNT))
+            working_name = GetRunName();
+        ImGui::SameLine();
+        ImGui::SetNextItemWidth(75);
+        if (ImGui::Combo("##Size", &selected_size_idx, kPlotSizeStrings, IM_ARRAYSIZE(kPlotSizeStrings)))
+            working_name = GetRunName();
+        ImGui::SameLine();
+        ImGui::SetNextItemWidth(75);
+        if (ImGui::Combo("##Zoom", &selected_zoom_idx, kZoomStrings, IM_ARRAYSIZE(kZoomStrings)))
+            working_name = GetRunName();
+        ImGui::SameLine();
         if (ImGui::Checkbox("AA",&selected_aa))
             working_name = GetRunName();
         ImGui::SameLine();
+        if (ImGui::Checkbox("Finish", &selected_finish))
+            working_name = GetRunName();
+        ImGui::SameLine();
+        ImGui::SetNextItemWidth(75);
+        ImGui::SliderInt("##Trials", &num_trials, 1, 20, "%d trials");
+        ImGui::SameLine();
         ImGui::SetNextItemWidth(125);
         ImGui::InputText("##Name", &working_name);
         if (was_running)
@@ -626,7 +1263,7 @@ struct ImPlotBench : App
         ImGui::SameLine();
         if (ImGui::Button("+"))
         {
-            m_queue.push_back({selected_bench_idx, selected_type_idx, selected_elems_idx, selected_aa, working_name});
+            m_queue.push_back({selected_bench_idx, selected_type_idx, selected_elems_idx, selected_aa, working_name, selected_data_idx, selected_size_idx, selected_zoom_idx, selected_finish});
         }
         ImGui::SameLine();
         ImGui::SetNextItemWidth(75);
@@ -649,11 +1286,12 @@ struct ImPlotBench : App
         if (ImGui::Button(start_str, ImVec2(-1, 0)))
         {
             running = !running;
-            current_items = current_frame = 0;
+            current_items = 0;
+            ResetStep();
             if (running)
             {
                 if (m_queue.size() == 0)
-                    m_queue.push_back({selected_bench_idx, selected_type_idx, selected_elems_idx, selected_aa, working_name});
+                    m_queue.push_back({selected_bench_idx, selected_type_idx, selected_elems_idx, selected_aa, working_name, selected_data_idx, selected_size_idx, selected_zoom_idx, selected_finish});
                 StartNextRun();
                 run_t1 = Clock::now();
             }
@@ -666,38 +1304,103 @@ struct ImPlotBench : App
         // if (ImGui::Button("X", ImVec2(-1,0)))
         //     m_queue.clear();
         ImGui::ProgressBar((float)current_items / (float)(working_items - 1));
+        if (ImPlot::PlotPyramidMemory() > 0)
+            ImGui::Text("Pyramid cache: %.2f MB", ImPlot::PlotPyramidMemory() / 1e6);
 
         GImGui->Style.AntiAliasedLines = GImGui->Style.AntiAliasedLinesUseTex = working_aa;
 
-        if (ImPlot::BeginPlot("##Bench", ImVec2(-1, -1), ImPlotFlags_CanvasOnly))
+        // plots larger than the window are clipped by ImGui but still generate
+        // all of their vertices, so the CPU cost is still measured
+        auto RunSelected = [&]()
         {
-            ImPlot::SetupAxesLimits(0, kMaxElemsItem, kMaxElemsItem-kDataNoise, kMaxElems+kDataNoise, ImGuiCond_Always);
-            ImPlot::SetupAxes(NULL, NULL, ImPlotAxisFlags_NoDecorations, ImPlotAxisFlags_NoDecorations);
+            switch (selected_type_idx)
+            {
+            case BenchmarkType_Int:
+                m_benchmarks[selected_bench_idx]->RunInt(m_items_int, current_items, working_elems, tcall);
+                break;
+            case BenchmarkType_Float:
+                m_benchmarks[selected_bench_idx]->RunFloat(m_items_float, current_items, working_elems, tcall);
+                break;
+            case BenchmarkType_Double:
+                m_benchmarks[selected_bench_idx]->RunDouble(m_items_double, current_items, working_elems, tcall);
+                break;
+            case BenchmarkType_ImVec2:
+                m_benchmarks[selected_bench_idx]->RunImVec2(m_items_imvec2, current_items, working_elems, tcall);
+                break;
+            case BenchmarkType_ImPlotPoint:
+                m_benchmarks[selected_bench_idx]->RunImPlotPoint(m_items_implot, current_items, working_elems, tcall);
+                break;
+            default:
+                break;
+            }
+        };
+
+        m_finish = selected_finish;
+        if (running)
+            m_gpu.StampDrawList(ImGui::GetWindowDrawList(), BenchmarkGpuTimer::Stamp_PlotBegin);
+
+        if (m_benchmarks[selected_bench_idx]->max_plots > 0)
+        {
+            // layout benchmarks draw their own plots, the grid setup is timed too
+            auto &layout = static_cast<IBenchmarkLayout &>(*m_benchmarks[selected_bench_idx]);
             if (running)
             {
-                switch (selected_type_idx)
+                double tlayout = 0;
+                {
+                    ScopedProfiler prof(tlayout);
+                    layout.BeginLayout();
+                }
+                RunSelected();
                 {
-                case BenchmarkType_Int:
-                    m_benchmarks[selected_bench_idx]->RunInt(m_items_int, current_items, working_elems, tcall);
-                    break;
-                case BenchmarkType_Float:
-                    m_benchmarks[selected_bench_idx]->RunFloat(m_items_float, current_items, working_elems, tcall);
-                    break;
-                case BenchmarkType_Double:
-                    m_benchmarks[selected_bench_idx]->RunDouble(m_items_double, current_items, working_elems, tcall);
-                    break;
-                case BenchmarkType_ImVec2:
-                    m_benchmarks[selected_bench_idx]->RunImVec2(m_items_imvec2, current_items, working_elems, tcall);
-                    break;
-                case BenchmarkType_ImPlotPoint:
-                    m_benchmarks[selected_bench_idx]->RunImPlotPoint(m_items_implot, current_items, working_elems, tcall);
-                    break;
-                default:
-                    break;
+                    ScopedProfiler prof(tlayout);
+                    layout.EndLayout();
                 }
+                tcall += tlayout;
             }
+        }
+        else if (ImPlot::BeginPlot("##Bench", kPlotSizes[selected_size_idx], ImPlotFlags_CanvasOnly))
+        {
+            double x_min, x_max;
+            BenchmarkDatasetXLimits(m_dataset, kMaxElemsItem, &x_min, &x_max);
+            const double x_mid = (x_min + x_max) / 2;
+            const double x_half = (x_max - x_min) / 2 / kZoomValues[selected_zoom_idx];
+            x_min = x_mid - x_half;
+            x_max = x_mid + x_half;
+            ImPlot::SetupAxesLimits(x_min, x_max, kMaxElemsItem-kDataNoise, kMaxElems+kDataNoise, ImGuiCond_Always);
+            ImPlot::SetupAxes(NULL, NULL, ImPlotAxisFlags_NoDecorations, ImPlotAxisFlags_NoDecorations);
+            if (running)
+                RunSelected();
             ImPlot::EndPlot();
         }
+
+        if (running)
+            m_gpu.StampDrawList(ImGui::GetWindowDrawList(), BenchmarkGpuTimer::Stamp_PlotEnd);
+
+        // everything in this window, including the plots, goes to its draw list
+        if (running && current_frame >= kWarmupFrames)
+        {
+            ImDrawList &draw_list = *ImGui::GetWindowDrawList();
+            tdraw += draw_list.VtxBuffer.size_in_bytes() + draw_list.IdxBuffer.size_in_bytes();
+        }
+    }
+
+    static void PlotStats(const char *name, const std::vector<float> &elems, const BenchmarkStats &stats, bool fit, bool data, bool spread, float weight = IMPLOT_AUTO)
+    {
+        if (spread)
+        {
+            ImPlot::SetNextFillStyle(IMPLOT_AUTO_COL, 0.25f);
+            ImPlot::PlotShaded(name, elems.data(), stats.Lo.data(), stats.Hi.data(), elems.size());
+        }
+        if (fit)
+        {
+            ImPlot::SetNextLineStyle(IMPLOT_AUTO_COL, weight);
+            ImPlot::PlotLine(name, &stats.Fit[0].x, &stats.Fit[0].y, 2, 0, 0, sizeof(ImVec2));
+        }
+        if (data)
+        {
+            ImPlot::SetNextMarkerStyle(ImPlotMarker_Square, 3);
+            ImPlot::PlotScatter(name, elems.data(), stats.Median.data(), elems.size());
+        }
     }
 
     void ShowResultsTool()
@@ -705,9 +1408,14 @@ struct ImPlotBench : App
         static bool show_call_time = true;
         static bool show_frame_time = false;
         static bool show_fps = false;
+        static bool show_submit = false;
+        static bool show_gpu = false;
         static bool show_fit = true;
         static bool show_data = false;
-        static std::string selected_branch = m_branch;
+        static bool show_spread = true;
+        static int show_memory = 0;
+        static const char *memory_names[] = {"No Memory", "RSS Growth [MB]", "Draw Lists [KB]", "Allocs/Frame"};
+        static std::string selected_branch = m_group;
 
         if (ImGui::Button("Clear"))
             m_records[selected_branch].clear();
@@ -718,10 +1426,19 @@ struct ImPlotBench : App
         ImGui::SameLine();
         ImGui::Checkbox("FPS", &show_fps);
         ImGui::SameLine();
+        ImGui::Checkbox("Submit", &show_submit);
+        ImGui::SameLine();
+        ImGui::Checkbox("GPU", &show_gpu);
+        ImGui::SameLine();
         ImGui::Checkbox("Fit", &show_fit);
         ImGui::SameLine();
         ImGui::Checkbox("Data", &show_data);
         ImGui::SameLine();
+        ImGui::Checkbox("Spread", &show_spread);
+        ImGui::SameLine();
+        ImGui::SetNextItemWidth(125);
+        ImGui::Combo("##Memory", &show_memory, memory_names, IM_ARRAYSIZE(memory_names));
+        ImGui::SameLine();
         ImGui::SetNextItemWidth(-1);
         if (ImGui::BeginCombo("##Branch", selected_branch.c_str()))
         {
@@ -751,6 +1468,8 @@ struct ImPlotBench : App
             ImPlot::SetupLegend(ImPlotLocation_East, ImPlotLegendFlags_Outside);
             if (show_fps)
                 ImPlot::SetupAxis(ImAxis_Y2, "FPS [Hz]", ImPlotAxisFlags_Opposite);
+            if (show_memory)
+                ImPlot::SetupAxis(ImAxis_Y3, memory_names[show_memory], ImPlotAxisFlags_Opposite | ImPlotAxisFlags_AutoFit);
 
             for (auto &collection : m_records[selected_branch])
             {
@@ -758,6 +1477,7 @@ struct ImPlotBench : App
                 auto col = collection.second.Col;
                 ImPlot::PushStyleColor(ImPlotCol_Line, col);
                 ImPlot::PushStyleColor(ImPlotCol_MarkerFill, col);
+                ImPlot::PushStyleColor(ImPlotCol_Fill, col);
 
                 for (auto &record : collection.second.Records)
                 {
@@ -766,41 +1486,33 @@ struct ImPlotBench : App
 
                         ImPlot::SetAxis(ImAxis_Y1);
                         if (show_call_time)
-                        {
-                            if (show_fit)
-                            {
-                                ImPlot::PlotLine(name, &record.Call_Fit[0].x, &record.Call_Fit[0].y, 2, 0, 0, sizeof(ImVec2));
-                            }
-                            if (show_data)
-                            {
-                                ImPlot::SetNextMarkerStyle(ImPlotMarker_Square, 3);
-                                ImPlot::PlotScatter(name, record.Elems.data(), record.Call.data(), record.Elems.size());
-                            }
-                        }
+                            PlotStats(name, record.Elems, record.Call, show_fit, show_data, show_spread);
                         if (show_frame_time)
+                            PlotStats(name, record.Elems, record.Frame, show_fit, show_data, show_spread, 2.0f);
+                        if (show_submit && record.HasRender())
+                            PlotStats(name, record.Elems, record.Submit, show_fit, show_data, show_spread);
+                        if (show_gpu && record.HasRender())
                         {
-                            if (show_fit)
-                            {
-                                ImPlot::SetNextLineStyle(IMPLOT_AUTO_COL, 2.0f);
-                                ImPlot::PlotLine(name, &record.Frame_Fit[0].x, &record.Frame_Fit[0].y, 2, 0, 0, sizeof(ImVec2));
-                            }
-                            if (show_data)
-                            {
-                                ImPlot::SetNextMarkerStyle(ImPlotMarker_Square, 3);
-                                ImPlot::PlotScatter(name, record.Elems.data(), record.Frame.data(), record.Elems.size());
-                            }
+                            PlotStats(name, record.Elems, record.Upload, show_fit, show_data, show_spread);
+                            PlotStats(name, record.Elems, record.Draw, show_fit, show_data, show_spread, 2.0f);
                         }
                         if (show_fps)
                         {
                             ImPlot::SetAxis(ImAxis_Y2);
-                            ImPlot::PlotLine(name, record.Elems.data(), record.Fps.data(), record.Elems.size());
+                            ImPlot::PlotLine(name, record.Elems.data(), record.Fps.Median.data(), record.Elems.size());
                             static double sixty = 60;
                             ImPlot::DragLineY(0, &sixty, ImVec4(1,1,0,1), 1, ImPlotDragToolFlags_NoInputs);
                             ImPlot::TagY(sixty, ImVec4(1,1,0,1), "60");
                         }
+                        if (show_memory && record.HasMemory() && (show_memory > 1 || record.HasRssGrowth()))
+                        {
+                            ImPlot::SetAxis(ImAxis_Y3);
+                            const BenchmarkStats *mem[] = {&record.RssGrowth, &record.DrawKB, &record.Allocs};
+                            PlotStats(name, record.Elems, *mem[show_memory - 1], show_fit && show_memory > 1, true, show_spread);
+                        }
                     }
                 }
-                ImPlot::PopStyleColor(2);
+                ImPlot::PopStyleColor(3);
             }
             ImPlot::EndPlot();
         }
@@ -808,8 +1520,10 @@ struct ImPlotBench : App
 
     void ShowCompareTool()
     {
-        static std::string branchL = m_branch;
-        static std::string branchR = m_branch;
+        static std::string branchL = m_group;
+        static std::string branchR = m_group;
+        static BenchmarkCompareOptions opts;
+        static float threshold = 5;
 
         float w = (ImGui::GetContentRegionAvail().x - ImGui::GetStyle().ItemSpacing.x) / 2;
         ImGui::SetNextItemWidth(w);
@@ -834,197 +1548,99 @@ struct ImPlotBench : App
             ImGui::EndCombo();
         }
 
-
-
-        static std::vector<std::string> bench_union;
-        bench_union.clear();
-
-        for (auto &bench : m_records[branchL])
+        ImGui::SetNextItemWidth(100);
+        if (ImGui::SliderFloat("##Threshold", &threshold, 0.5f, 25.0f, "threshold %.1f%%"))
+            opts.Threshold = threshold / 100;
+        ImGui::SameLine();
+        ImGui::SetNextItemWidth(100);
+        float alpha = (float)opts.Alpha;
+        if (ImGui::SliderFloat("##Alpha", &alpha, 0.001f, 0.1f, "alpha %.3f"))
+            opts.Alpha = alpha;
+        ImGui::SameLine();
+        ImGui::SetNextItemWidth(-1);
+        if (ImGui::BeginCombo("##Reference", opts.Reference.empty() ? "No Normalization" : opts.Reference.c_str()))
         {
-            if (m_records[branchR].count(bench.first))
-                bench_union.push_back(bench.first);
+            if (ImGui::Selectable("No Normalization", opts.Reference.empty()))
+                opts.Reference.clear();
+            for (auto &bench : m_records[branchL])
+            {
+                if (m_records[branchR].count(bench.first) && ImGui::Selectable(bench.first.c_str(), bench.first == opts.Reference))
+                    opts.Reference = bench.first;
+            }
+            ImGui::EndCombo();
         }
 
-        int numPlots = bench_union.size();
+        auto cmps = CompareBenchmarks(m_records[branchL], m_records[branchR], opts);
+        int numPlots = cmps.size();
         if (numPlots == 0)
             return;
 
-        static std::vector<float> bar;
+        static const ImVec4 verdict_cols[] = {{1, 1, 1, 1}, {0, 1, 0.5f, 1}, {1, 1, 0, 1}, {1, 0.25f, 0.25f, 1}};
+        const char *unit = opts.Reference.empty() ? "ms" : "rel";
+        const float table_h = ImMin(ImGui::GetContentRegionAvail().y * 0.5f, ImGui::GetFrameHeight() * (numPlots + 1.5f));
+        if (ImGui::BeginTable("##Table", 6, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY | ImGuiTableFlags_Resizable, ImVec2(0, table_h)))
+        {
+            ImGui::TableSetupScrollFreeze(0, 1);
+            ImGui::TableSetupColumn("Benchmark");
+            ImGui::TableSetupColumn(branchL.c_str());
+            ImGui::TableSetupColumn(branchR.c_str());
+            ImGui::TableSetupColumn("Speedup");
+            ImGui::TableSetupColumn("p");
+            ImGui::TableSetupColumn("Verdict");
+            ImGui::TableHeadersRow();
+            for (auto &c : cmps)
+            {
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(c.Name.c_str());
+                ImGui::TableNextColumn();
+                ImGui::Text("%.3f %s (%d)", c.Base, unit, c.Trials[0]);
+                ImGui::TableNextColumn();
+                ImGui::Text("%.3f %s (%d)", c.Head, unit, c.Trials[1]);
+                ImGui::TableNextColumn();
+                ImGui::Text("%.3fx", c.Speedup);
+                ImGui::TableNextColumn();
+                ImGui::Text("%.4f", c.PValue);
+                ImGui::TableNextColumn();
+                ImGui::TextColored(verdict_cols[c.Verdict], "%s", BenchmarkVerdict_Names[c.Verdict]);
+            }
+            ImGui::EndTable();
+        }
+
+        static std::vector<double> change;
         static std::vector<const char *> labels;
-        static const char *branchLabels[2];
-        static double positions[2] = {0, 1};
-        bar.resize(numPlots * 2);
+        change.resize(numPlots);
         labels.resize(numPlots);
-
-        branchLabels[0] = branchL.c_str();
-        branchLabels[1] = branchR.c_str();
-
-        for (int i = 0; i < numPlots * 2; i += 2)
+        for (int i = 0; i < numPlots; ++i)
         {
-            auto &bench = bench_union[i / 2];
-            bar[i] = ImSum(m_records[branchL][bench].Records[0].Call.data(), m_records[branchL][bench].Records[0].Call.size());
-            bar[i + 1] = ImSum(m_records[branchR][bench].Records[0].Call.data(), m_records[branchR][bench].Records[0].Call.size());
-            labels[i / 2] = bench.c_str();
+            change[i] = 100.0 * (cmps[i].Speedup - 1);
+            labels[i] = cmps[i].Name.c_str();
         }
 
-        int groups = 2;
-
-        if (ImPlot::BeginPlot("##Comp", ImVec2(-1, -1)))
+        if (ImPlot::BeginPlot("##Comp", ImVec2(-1, -1), ImPlotFlags_NoLegend))
         {
-            ImPlot::SetupAxis(ImAxis_X1, "##Bars", ImPlotAxisFlags_NoGridLines | ImPlotAxisFlags_NoTickMarks);
-            ImPlot::SetupAxisTicks(ImAxis_X1, 0, 1, 2, branchLabels);
-            ImPlot::SetupAxis(ImAxis_Y1, "Total Time [ms]", ImPlotAxisFlags_AutoFit);
-            ImPlot::PlotBarGroups(labels.data(), bar.data(), numPlots, 2);
+            ImPlot::SetupAxis(ImAxis_X1, "##Bars", ImPlotAxisFlags_AutoFit | ImPlotAxisFlags_NoGridLines | ImPlotAxisFlags_NoTickMarks);
+            ImPlot::SetupAxisTicks(ImAxis_X1, 0, numPlots - 1, numPlots, labels.data());
+            ImPlot::SetupAxis(ImAxis_Y1, "Speedup [%]", ImPlotAxisFlags_AutoFit);
+            for (int i = 0; i < numPlots; ++i)
+            {
+                ImGui::PushID(i);
+                ImPlot::SetNextFillStyle(verdict_cols[cmps[i].Verdict]);
+                double x = i;
+                ImPlot::PlotBars("##Speedup", &x, &change[i], 1, 0.67);
+                ImGui::PopID();
+            }
             ImPlot::EndPlot();
         }
-
-        // int rows = IM_ROUND(ImSqrt(numPlots));
-        // int cols = (numPlots / rows) * rows >= numPlots ? (numPlots / rows) : (numPlots / rows) + 1;
-        // if (ImPlot::BeginSubplots("##Comp",rows,cols,ImVec2(-1,-1),ImPlotSubplotFlags_NoResize)) {
-        //     for (auto& bench : bench_union) {
-        //         if (ImPlot::BeginPlot(bench.c_str(), ImVec2(0,0), ImPlotFlags_NoLegend)) {
-        //             ImPlot::SetupAxis(ImAxis_X1, "##X", ImPlotAxisFlags_NoTickLabels|ImPlotAxisFlags_NoGridLines|ImPlotAxisFlags_NoTickMarks);
-        //             ImPlot::SetupAxisLimits(ImAxis_X1,-0.5,1.5f,ImPlotCond_Always);
-        //             ImPlot::SetupAxis(ImAxis_Y1, "Total Time [ms]",ImPlotAxisFlags_AutoFit);
-        //             float v[2];
-        //             v[0] = ImSum(m_records[branchL][bench].Records[0].Call.data(), m_records[branchL][bench].Records[0].Call.size());
-        //             v[1] = ImSum(m_records[branchR][bench].Records[0].Call.data(), m_records[branchR][bench].Records[0].Call.size());
-        //             ImPlot::SetNextFillStyle(m_records[branchL][bench].Col);
-        //             ImPlot::PlotBars("##Item",v,2);
-        //             ImPlot::EndPlot();
-        //         }
-        //     }
-        //     ImPlot::EndSubplots();
-        // }
     }
 };
 
-typedef int ImPlotSpec;
-enum ImPlotSpec_ {
-    ImPlotSpec_LineWeight,
-    ImPlotSpec_LineColor,
-    ImPlotSpec_FaceColor,
-    ImPlotSpec_EdgeColor,
-    ImPlotSpec_Marker,
-    ImPlotSpec_MarkerSize,
-    ImPlotSpec_MarkerFaceColor,
-    ImPlotSpec_MarkerEdgeColor,
-    ImPlotSpec_Stride,
-    ImPlotSpec_Offset,
-};
-
-struct ImPlotSpecData {
-    float LineWeight = 1.0f;
-    ImVec4 LineColor = IMPLOT_AUTO_COL;
-    ImVec4 FaceColor = IMPLOT_AUTO_COL;
-    ImVec4 EdgeColor = IMPLOT_AUTO_COL;
-    ImPlotMarker Marker = ImPlotMarker_None;
-    float MarkerSize = 4.0f;
-    ImVec4 MarkerFaceColor = IMPLOT_AUTO_COL;
-    ImVec4 MarkerEdgeColor = IMPLOT_AUTO_COL;
-    int    Stride = 1;
-    int    Offset = 0;
-};
-
-NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(ImPlotSpecData, LineWeight, LineColor, FaceColor, EdgeColor, Marker, MarkerSize, MarkerFaceColor, MarkerEdgeColor, Stride, Offset);
-
-constexpr unsigned int str2int(const char* str, int h = 0)
-{
-    return !str[h] ? 5381 : (str2int(str, h+1) * 33) ^ str[h];
-}
-
-constexpr void BuildSpec(ImPlotSpecData& S, ImPlotSpec spec, const float& v) {
-    switch (spec) {
-        case ImPlotSpec_LineWeight : S.LineWeight = v; return;
-        case ImPlotSpec_MarkerSize : S.MarkerSize = v; return;
-    }
-}
-
-constexpr void BuildSpec(ImPlotSpecData& S, const char* spec, const float& v) {
-    switch (str2int(spec)) {
-        case str2int("LineWeight") : S.LineWeight = v; return;
-        case str2int("MarkerSize") : S.MarkerSize = v; return;
-    }
-}
-
-constexpr void BuildSpec(ImPlotSpecData& S, ImPlotSpec spec, const ImPlotMarker_& v) {
-    static_assert(true, "Out of Spec!");
-    switch (spec) {
-        case ImPlotSpec_Marker : S.LineWeight = v; return;
-    }
-}
-
-constexpr void BuildSpec(ImPlotSpecData& S, const char* spec, const ImPlotMarker_& v) {
-    switch (str2int(spec)) {
-        case str2int("Marker") : S.LineWeight = v; return;
-    }
-}
-
-constexpr void BuildSpec(ImPlotSpecData& S, ImPlotSpec spec, const int& v) {
-    switch (spec) {
-        case ImPlotSpec_LineWeight : S.LineWeight = v; return;
-        case ImPlotSpec_Stride     : S.Stride     = v; return;
-        case ImPlotSpec_Offset     : S.Offset     = v; return;
-        case ImPlotSpec_Marker     : S.Marker     = v; return;
-    }
-}
-
-constexpr void BuildSpec(ImPlotSpecData& S, const char* spec, const int& v) {
-    switch (str2int(spec)) {
-        case str2int("LineWeight") : S.LineWeight = v; return;
-        case str2int("Stride")     : S.Stride     = v; return;
-        case str2int("Offset")     : S.Offset     = v; return;
-    }
-}
-
-constexpr void BuildSpec(ImPlotSpecData& S, ImPlotSpec spec, const ImVec4& v) {
-    switch (spec) {
-        case ImPlotSpec_LineColor       : S.LineColor = v;         return;
-        case ImPlotSpec_FaceColor       : S.FaceColor = v;         return;
-        case ImPlotSpec_EdgeColor       : S.EdgeColor = v;         return;
-        case ImPlotSpec_MarkerFaceColor : S.MarkerFaceColor = v;   return;
-        case ImPlotSpec_MarkerEdgeColor : S.MarkerEdgeColor = v;   return;
-    }
-}
-
-constexpr void BuildSpec(ImPlotSpecData& S, const char* spec, const ImVec4& v) {
-    switch (str2int(spec)) {
-        case str2int("LineColor")       : S.LineColor = v;        return;
-        case str2int("FaceColor")       : S.FaceColor = v;        return;
-        case str2int("EdgeColor")       : S.EdgeColor = v;        return;
-        case str2int("MarkerFaceColor") : S.MarkerFaceColor = v;  return;
-        case str2int("MarkerEdgeColor") : S.MarkerEdgeColor = v;  return;
-    }
-}
-
-template <typename Arg, typename ...Args>
-constexpr void BuildSpec(ImPlotSpecData& S, ImPlotSpec spec, const Arg& arg, Args... args) {
-    BuildSpec(S, spec, arg);
-    BuildSpec(S, args...);
-}
-
-template <typename Arg, typename ...Args>
-constexpr void BuildSpec(ImPlotSpecData& S, const char* spec, const Arg& arg, Args... args) {
-    BuildSpec(S, spec, arg);
-    BuildSpec(S, args...);
-}
-
-void PlotLine(const char* label, float* xs, float *ys, int count, const ImPlotSpecData& S) {
-    json j = S;
-    std::cout << std::setw(4) << j << std::endl;
-}
-
-template <typename ...Args>
-void PlotLine(const char* label, float* xs, float *ys, int count, Args... args) {
-    ImPlotSpecData S;
-    BuildSpec(S, args...);
-    PlotLine(label, xs, ys, count, S);
-}
-
 int main(int argc, char const *argv[])
 {
+    // before App creates the ImGui and ImPlot contexts, so every block they
+    // allocate goes through (and is freed by) the counting hooks
+    ImGui::SetAllocatorFunctions(CountingAlloc, CountingFree);
     ImPlotBench app(argc, argv);
     app.Run();
-    // PlotLine("MyLine", nullptr, nullptr, 10, "LineColor", ImVec4(1,0,0,1), "Marker", ImPlotMarker_Cross, "MarkerFaceColor", ImVec4(1,1,0,1), "MarkerSize", 5.0f);
     return 0;
 }
\ No newline at end of file
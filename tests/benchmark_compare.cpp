@@ -0,0 +1,115 @@
+// Command line comparator for the run logs (benchmark_runs.jsonl) written by
+// the benchmark tool; legacy benchmark.json files are accepted too, in either
+// record format (see LoadBenchmarkFile). Results are grouped as <branch>@<host>.
+// Exits with 1 if any benchmark regressed, so it can gate CI jobs:
+//
+//   benchmark_compare base.jsonl head.jsonl --threshold 0.03
+//   benchmark_compare benchmark_runs.jsonl --base master@bench01 --head my-branch@bench01
+//   benchmark_compare base.jsonl head.jsonl --reference Line_double_1000
+
+#include "benchmark_compare.h"
+#include "cxxopts.hpp"
+#include <cstdio>
+
+static bool SelectSet(const BenchmarkRecordMap &records, const std::string &branch, const std::string &path, BenchmarkRecordSet &out)
+{
+    if (branch.empty())
+    {
+        if (records.size() != 1)
+        {
+            fprintf(stderr, "%s contains %d branch@host groups, select one with --base/--head\n", path.c_str(), (int)records.size());
+            return false;
+        }
+        out = records.begin()->second;
+        return true;
+    }
+    if (!records.count(branch))
+    {
+        fprintf(stderr, "%s has no results for '%s'\n", path.c_str(), branch.c_str());
+        return false;
+    }
+    out = records.at(branch);
+    return true;
+}
+
+int main(int argc, char const *argv[])
+{
+    cxxopts::Options options("benchmark_compare", "Compare two sets of ImPlot benchmark results");
+    options.add_options()
+        ("files", "base and (optionally) head run log or benchmark.json", cxxopts::value<std::vector<std::string>>())
+        ("b,base", "Group (branch@host) to use as baseline", cxxopts::value<std::string>()->default_value(""))
+        ("h,head", "Group (branch@host) to compare against the baseline", cxxopts::value<std::string>()->default_value(""))
+        ("t,threshold", "Relative slowdown reported as a regression", cxxopts::value<double>()->default_value("0.05"))
+        ("a,alpha", "Significance level", cxxopts::value<double>()->default_value("0.05"))
+        ("r,reference", "Normalize both sides by this benchmark (cross-machine)", cxxopts::value<std::string>()->default_value(""))
+        ("help", "Show Help");
+    options.parse_positional({"files"});
+    options.positional_help("base.json [head.json]");
+
+    cxxopts::ParseResult result;
+    try
+    {
+        result = options.parse(argc, argv);
+    }
+    catch (const cxxopts::OptionException &e)
+    {
+        fprintf(stderr, "%s\n", e.what());
+        return 2;
+    }
+    if (result.count("help") || !result.count("files"))
+    {
+        printf("%s\n", options.help().c_str());
+        return result.count("help") ? 0 : 2;
+    }
+
+    auto files = result["files"].as<std::vector<std::string>>();
+    if (files.size() > 2)
+    {
+        fprintf(stderr, "expected at most two result files\n");
+        return 2;
+    }
+    const std::string base_path = files[0];
+    const std::string head_path = files.size() > 1 ? files[1] : files[0];
+
+    BenchmarkRecordMap base_records, head_records;
+    if (!LoadBenchmarkFile(base_path, base_records) || !LoadBenchmarkFile(head_path, head_records))
+    {
+        fprintf(stderr, "failed to load results\n");
+        return 2;
+    }
+
+    BenchmarkRecordSet base, head;
+    if (!SelectSet(base_records, result["base"].as<std::string>(), base_path, base) ||
+        !SelectSet(head_records, result["head"].as<std::string>(), head_path, head))
+        return 2;
+
+    BenchmarkCompareOptions opts;
+    opts.Threshold = result["threshold"].as<double>();
+    opts.Alpha = result["alpha"].as<double>();
+    opts.Reference = result["reference"].as<std::string>();
+    if (!opts.Reference.empty() && (!base.count(opts.Reference) || !head.count(opts.Reference)))
+    {
+        fprintf(stderr, "reference benchmark '%s' missing from one side\n", opts.Reference.c_str());
+        return 2;
+    }
+
+    auto cmps = CompareBenchmarks(base, head, opts);
+    if (cmps.empty())
+    {
+        fprintf(stderr, "no common benchmarks to compare\n");
+        return 2;
+    }
+
+    const char *unit = opts.Reference.empty() ? "ms" : "rel";
+    printf("%-36s %12s %12s %9s %9s %7s  %s\n", "benchmark", "base", "head", "speedup", "p", "trials", "verdict");
+    int regressions = 0;
+    for (auto &c : cmps)
+    {
+        printf("%-36s %9.3f %-2s %9.3f %-2s %8.3fx %9.4f %3d/%-3d  %s\n", c.Name.c_str(), c.Base, unit, c.Head, unit,
+               c.Speedup, c.PValue, c.Trials[0], c.Trials[1], BenchmarkVerdict_Names[c.Verdict]);
+        if (c.Verdict == BenchmarkVerdict_Regression)
+            regressions++;
+    }
+    printf("\n%d of %d benchmarks regressed by more than %.1f%% (alpha = %.3f)\n", regressions, (int)cmps.size(), opts.Threshold * 100, opts.Alpha);
+    return regressions > 0 ? 1 : 0;
+}
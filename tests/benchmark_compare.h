@@ -0,0 +1,146 @@
+#pragma once
+
+#include <iterator>
+#include "benchmark_record.h"
+
+// Compares two sets of benchmark results (e.g. two branches). Runs are matched
+// by name and only the steps (element counts) present in every record of both
+// sides are considered. For each trial index the call times of those steps are
+// summed, giving one total per trial; the two samples of totals are then tested
+// with Welch's t-test on a log scale, so the test is on the ratio of run times.
+
+struct BenchmarkCompareOptions
+{
+    double Threshold = 0.05; // relative slowdown that counts as a regression
+    double Alpha = 0.05;     // significance level
+    std::string Reference;   // run used to normalize machine speed, empty for none
+};
+
+enum BenchmarkVerdict
+{
+    BenchmarkVerdict_Same = 0,
+    BenchmarkVerdict_Faster,
+    BenchmarkVerdict_Slower,
+    BenchmarkVerdict_Regression
+};
+
+static const char *BenchmarkVerdict_Names[] = {"same", "faster", "slower", "REGRESSION"};
+
+struct BenchmarkComparison
+{
+    std::string Name;
+    double Base = 0;    // median trial total, ms (or relative to reference)
+    double Head = 0;
+    double Speedup = 1; // Base / Head, > 1 means head is faster
+    double PValue = 1;
+    int Trials[2] = {0, 0};
+    BenchmarkVerdict Verdict = BenchmarkVerdict_Same;
+};
+
+// steps common to every record of both collections
+inline std::vector<float> CommonBenchmarkSteps(const BenchmarkRecordCollection &a, const BenchmarkRecordCollection &b)
+{
+    std::vector<float> common;
+    bool first = true;
+    for (auto *col : {&a, &b})
+    {
+        for (auto &rec : col->Records)
+        {
+            std::vector<float> elems = rec.Elems;
+            std::sort(elems.begin(), elems.end());
+            if (first)
+                common = elems;
+            else
+            {
+                std::vector<float> tmp;
+                std::set_intersection(common.begin(), common.end(), elems.begin(), elems.end(), std::back_inserter(tmp));
+                common = tmp;
+            }
+            first = false;
+        }
+    }
+    return common;
+}
+
+// one total call time per trial, summed over the given steps
+inline std::vector<double> BenchmarkTrialTotals(const BenchmarkRecordCollection &col, const std::vector<float> &steps)
+{
+    std::vector<double> totals;
+    for (auto &rec : col.Records)
+    {
+        size_t trials = 0;
+        for (auto &t : rec.Call.Trials)
+            trials = (trials == 0) ? t.size() : std::min(trials, t.size());
+        std::vector<double> sums(trials, 0.0);
+        for (size_t s = 0; s < rec.Elems.size() && s < rec.Call.Trials.size(); ++s)
+        {
+            if (!std::binary_search(steps.begin(), steps.end(), rec.Elems[s]))
+                continue;
+            for (size_t t = 0; t < trials; ++t)
+                sums[t] += rec.Call.Trials[s][t];
+        }
+        totals.insert(totals.end(), sums.begin(), sums.end());
+    }
+    return totals;
+}
+
+inline BenchmarkComparison CompareBenchmark(const std::string &name, const BenchmarkRecordCollection &base, const BenchmarkRecordCollection &head, double base_norm, double head_norm, const BenchmarkCompareOptions &opts)
+{
+    BenchmarkComparison cmp;
+    cmp.Name = name;
+    auto steps = CommonBenchmarkSteps(base, head);
+    auto tb = BenchmarkTrialTotals(base, steps);
+    auto th = BenchmarkTrialTotals(head, steps);
+    cmp.Trials[0] = (int)tb.size();
+    cmp.Trials[1] = (int)th.size();
+    if (tb.empty() || th.empty())
+        return cmp;
+    for (auto &v : tb)
+        v /= base_norm;
+    for (auto &v : th)
+        v /= head_norm;
+    cmp.Base = ImMedian(tb);
+    cmp.Head = ImMedian(th);
+    cmp.Speedup = cmp.Head > 0 ? cmp.Base / cmp.Head : 1;
+    std::vector<double> lb, lh;
+    for (auto &v : ImRejectOutliers(tb))
+        lb.push_back(std::log(std::max(v, 1e-12)));
+    for (auto &v : ImRejectOutliers(th))
+        lh.push_back(std::log(std::max(v, 1e-12)));
+    cmp.PValue = ImWelchTTest(lb, lh);
+    if (cmp.PValue < opts.Alpha)
+    {
+        if (cmp.Speedup > 1)
+            cmp.Verdict = BenchmarkVerdict_Faster;
+        else if (1 / cmp.Speedup - 1 > opts.Threshold)
+            cmp.Verdict = BenchmarkVerdict_Regression;
+        else
+            cmp.Verdict = BenchmarkVerdict_Slower;
+    }
+    return cmp;
+}
+
+// Median trial total of the reference run, or 1 if it is missing so that raw
+// times are compared.
+inline double BenchmarkReferenceNorm(const BenchmarkRecordSet &set, const BenchmarkRecordSet &other, const std::string &reference)
+{
+    if (reference.empty() || !set.count(reference) || !other.count(reference))
+        return 1;
+    auto steps = CommonBenchmarkSteps(set.at(reference), other.at(reference));
+    double norm = ImMedian(BenchmarkTrialTotals(set.at(reference), steps));
+    return norm > 0 ? norm : 1;
+}
+
+inline std::vector<BenchmarkComparison> CompareBenchmarks(const BenchmarkRecordSet &base, const BenchmarkRecordSet &head, const BenchmarkCompareOptions &opts)
+{
+    const double base_norm = BenchmarkReferenceNorm(base, head, opts.Reference);
+    const double head_norm = BenchmarkReferenceNorm(head, base, opts.Reference);
+    std::vector<BenchmarkComparison> results;
+    for (auto &bench : base)
+    {
+        if (!head.count(bench.first) || bench.first == opts.Reference)
+            continue;
+        results.push_back(CompareBenchmark(bench.first, bench.second, head.at(bench.first), base_norm, head_norm, opts));
+    }
+    return results;
+}
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <string>
+#include "Helpers.h"
+
+// Synthetic datasets for the benchmark tools. Data is generated as a number of
+// series laid out back to back; every series has x in [0,count) (see
+// BenchmarkDatasetXLimits for exceptions) and y within y0 +/- amp. Generation
+// is seeded, so all data types and runs see the same values.
+
+enum BenchmarkDataset
+{
+    BenchmarkDataset_Noise = 0,    // uniform noise, monotonic x
+    BenchmarkDataset_RandomWalk,   // bounded random walk
+    BenchmarkDataset_Sinusoid,     // sinusoid near the Nyquist rate, every segment spans the band
+    BenchmarkDataset_Spikes,       // flat signal with sparse full scale spikes
+    BenchmarkDataset_NaNGaps1,     // noise with 1% NaN, one point every 100 (no gaps for int)
+    BenchmarkDataset_NaNGaps10,    // noise with 10% NaN, runs of 10 every 100
+    BenchmarkDataset_NaNGaps50,    // noise with 50% NaN, runs of 50 every 100
+    BenchmarkDataset_NonMonotonic, // x drawn at random, lines zig-zag across the plot
+    BenchmarkDataset_Timestamps,   // x as epoch seconds (~1.6e9)
+    BenchmarkDataset_Offscreen,    // x stretched so ~90% of each series is outside the plot
+    BenchmarkDataset_COUNT
+};
+
+static const char *BenchmarkDataset_Names[] = {"Noise", "RandomWalk", "Sinusoid", "Spikes", "NaNGaps1", "NaNGaps10", "NaNGaps50", "NonMonotonic", "Timestamps", "Offscreen"};
+
+static constexpr double kBenchmarkTimestamp = 1.6e9;
+
+// x axis limits that frame one series of count points
+inline void BenchmarkDatasetXLimits(BenchmarkDataset set, int count, double *x_min, double *x_max)
+{
+    *x_min = set == BenchmarkDataset_Timestamps ? kBenchmarkTimestamp : 0;
+    *x_max = *x_min + count;
+}
+
+template <typename T>
+inline T BenchmarkNaN(T fallback)
+{
+    return std::numeric_limits<T>::has_quiet_NaN ? std::numeric_limits<T>::quiet_NaN() : fallback;
+}
+
+// NaN points per 100 of the NaNGaps datasets, 0 for the others
+inline int BenchmarkGapLength(BenchmarkDataset set)
+{
+    return set == BenchmarkDataset_NaNGaps1 ? 1 : set == BenchmarkDataset_NaNGaps10 ? 10 : set == BenchmarkDataset_NaNGaps50 ? 50 : 0;
+}
+
+// Fills one series of count points.
+template <typename T>
+inline void GenerateBenchmarkSeries(BenchmarkDataset set, T *xs, T *ys, int count, double y0, double amp)
+{
+    const int gap = BenchmarkGapLength(set);
+    double walk = 0;
+    for (int j = 0; j < count; ++j)
+    {
+        double x = j;
+        double y = y0 + RandomRange<double>(-amp, amp);
+        switch (set)
+        {
+        case BenchmarkDataset_RandomWalk:
+            walk += RandomRange<double>(-0.05, 0.05) * amp;
+            walk = walk > amp ? 2 * amp - walk : walk < -amp ? -2 * amp - walk : walk;
+            y = y0 + walk;
+            break;
+        case BenchmarkDataset_Sinusoid:
+            y = y0 + amp * sin(2 * 3.14159265358979 * 0.37 * j);
+            break;
+        case BenchmarkDataset_Spikes:
+            y = y0 + 0.02 * (y - y0);
+            if (RandomRange<double>(0, 1) < 0.01)
+                y = y0 + (RandomRange<double>(0, 1) < 0.5 ? -amp : amp);
+            break;
+        case BenchmarkDataset_NonMonotonic:
+            x = RandomRange<double>(0, count);
+            break;
+        case BenchmarkDataset_Timestamps:
+            x = kBenchmarkTimestamp + j;
+            break;
+        case BenchmarkDataset_Offscreen:
+            x = 10.0 * j;
+            break;
+        default:
+            break;
+        }
+        xs[j] = static_cast<T>(x);
+        ys[j] = static_cast<T>(y);
+        // one run of gap points every 100 points
+        if (j % 100 >= 100 - gap)
+            ys[j] = BenchmarkNaN(ys[j]);
+    }
+}
+
+// Fills count points as consecutive series of series_size points. Each series is
+// centered at y0 minus the index of its first point, matching the layout of the
+// benchmark plot.
+template <typename T>
+inline void GenerateBenchmarkData(BenchmarkDataset set, T *xs, T *ys, int count, int series_size, double y0, double amp)
+{
+    srand(0);
+    for (int i = 0; i < count; i += series_size)
+        GenerateBenchmarkSeries(set, &xs[i], &ys[i], std::min(series_size, count - i), y0 - i, amp);
+}
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <imgui.h>
+
+// GPU timing of the ImGui render pass with GL timestamp queries. Stamps are
+// taken before and after ImGui_ImplOpenGL3_RenderDrawData, and around the
+// benchmark plot through draw list callbacks, which the renderer runs after it
+// has uploaded that draw list's vertices and indices:
+//
+//   Begin .. upload (and anything drawn before the plot) .. PlotBegin
+//   PlotBegin .. plot draw calls .. PlotEnd
+//   Begin .. everything .. End
+//
+// Results are read kLatency frames later so the queries never stall the
+// pipeline, or in the same frame after glFinish. Timer queries are core in GL
+// 3.3 and available on Mesa llvmpipe, so this also works on CPU-only machines.
+struct BenchmarkGpuTimer
+{
+    enum Stamp
+    {
+        Stamp_Begin = 0,
+        Stamp_PlotBegin,
+        Stamp_PlotEnd,
+        Stamp_End,
+        Stamp_COUNT
+    };
+
+    static constexpr int kLatency = 4;
+
+    void Init()
+    {
+        // the vendored glad loads core profiles only, so no ARB_timer_query fallback
+        Supported = GLAD_GL_VERSION_3_3;
+        if (Supported)
+            glGenQueries(kLatency * Stamp_COUNT, &Queries[0][0]);
+        for (int s = 0; s < Stamp_COUNT; ++s)
+            Callbacks[s] = {this, (Stamp)s};
+    }
+
+    void Shutdown()
+    {
+        if (Supported)
+            glDeleteQueries(kLatency * Stamp_COUNT, &Queries[0][0]);
+        Supported = false;
+    }
+
+    void StampNow(Stamp stamp)
+    {
+        if (!Supported)
+            return;
+        const int slot = Frame % kLatency;
+        glQueryCounter(Queries[slot][stamp], GL_TIMESTAMP);
+        Issued[slot] |= 1 << stamp;
+    }
+
+    // Takes the stamp when the renderer reaches this point of the draw list.
+    void StampDrawList(ImDrawList *draw_list, Stamp stamp)
+    {
+        if (Supported)
+            draw_list->AddCallback(StampCallback, &Callbacks[stamp]);
+    }
+
+    // Call after the frame's last stamp. Resolves the oldest frame in flight, or
+    // this frame if the caller has waited for the GPU with glFinish.
+    void EndFrame(bool finished)
+    {
+        Ready = false;
+        if (!Supported)
+            return;
+        const int slot = Frame % kLatency;
+        const int read = finished ? slot : (slot + 1) % kLatency;
+        if (Issued[read] == (1 << Stamp_COUNT) - 1)
+        {
+            GLuint64 t[Stamp_COUNT];
+            for (int s = 0; s < Stamp_COUNT; ++s)
+                glGetQueryObjectui64v(Queries[read][s], GL_QUERY_RESULT, &t[s]);
+            Upload = (t[Stamp_PlotBegin] - t[Stamp_Begin]) * 1e-6;
+            Draw = (t[Stamp_PlotEnd] - t[Stamp_PlotBegin]) * 1e-6;
+            Total = (t[Stamp_End] - t[Stamp_Begin]) * 1e-6;
+            Ready = true;
+        }
+        Issued[read] = 0;
+        Frame++;
+    }
+
+    struct CallbackData
+    {
+        BenchmarkGpuTimer *Timer;
+        Stamp Which;
+    };
+
+    static void StampCallback(const ImDrawList *, const ImDrawCmd *cmd)
+    {
+        auto *data = (CallbackData *)cmd->UserCallbackData;
+        data->Timer->StampNow(data->Which);
+    }
+
+    bool Supported = false;
+    bool Ready = false; // results below are from a complete frame
+    double Upload = 0;  // ms
+    double Draw = 0;
+    double Total = 0;
+    GLuint Queries[kLatency][Stamp_COUNT] = {};
+    int Issued[kLatency] = {};
+    int Frame = 0;
+    CallbackData Callbacks[Stamp_COUNT];
+};
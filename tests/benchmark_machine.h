@@ -0,0 +1,127 @@
+#pragma once
+
+#include <chrono>
+#include <ctime>
+#include <string>
+#include <thread>
+#include "benchmark_record.h"
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#endif
+
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+// Build information is passed in by CMake, see the benchmark target.
+#ifndef BENCHMARK_COMPILER
+#define BENCHMARK_COMPILER "unknown"
+#endif
+#ifndef BENCHMARK_CXX_FLAGS
+#define BENCHMARK_CXX_FLAGS "unknown"
+#endif
+#ifndef BENCHMARK_BUILD_TYPE
+#define BENCHMARK_BUILD_TYPE "unknown"
+#endif
+#ifndef IMPLOT_DIR
+#define IMPLOT_DIR "../implot"
+#endif
+#ifndef IMGUI_DIR
+#define IMGUI_DIR "../imgui"
+#endif
+
+// CPU brand string from cpuid leaves 0x80000002-4
+inline std::string GetCpuName()
+{
+    char brand[49] = {};
+#if defined(_MSC_VER)
+    int regs[4];
+    __cpuid(regs, 0x80000000);
+    if ((unsigned)regs[0] < 0x80000004)
+        return "unknown";
+    for (int i = 0; i < 3; ++i)
+    {
+        __cpuid(regs, 0x80000002 + i);
+        memcpy(brand + 16 * i, regs, 16);
+    }
+#elif defined(__x86_64__) || defined(__i386__)
+    if (__get_cpuid_max(0x80000000, NULL) < 0x80000004)
+        return "unknown";
+    unsigned int regs[4];
+    for (int i = 0; i < 3; ++i)
+    {
+        __get_cpuid(0x80000002 + i, &regs[0], &regs[1], &regs[2], &regs[3]);
+        memcpy(brand + 16 * i, regs, 16);
+    }
+#else
+    return "unknown";
+#endif
+    std::string name = brand;
+    name.erase(0, name.find_first_not_of(' '));
+    name.erase(name.find_last_not_of(' ') + 1);
+    return name;
+}
+
+inline std::string GetHostName()
+{
+#ifdef _WIN32
+    const char *name = getenv("COMPUTERNAME");
+    return name ? name : "unknown";
+#else
+    char name[256] = {};
+    return gethostname(name, sizeof(name) - 1) == 0 ? name : "unknown";
+#endif
+}
+
+inline std::string GetOsName()
+{
+#if defined(_WIN32)
+    return "Windows";
+#elif defined(__APPLE__)
+    return "macOS";
+#elif defined(__linux__)
+    return "Linux";
+#else
+    return "unknown";
+#endif
+}
+
+// current local time as ISO 8601
+inline std::string GetDateString()
+{
+    std::time_t now = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+    std::tm tm = {};
+#ifdef _WIN32
+    localtime_s(&tm, &now);
+#else
+    localtime_r(&now, &tm);
+#endif
+    char buff[32];
+    strftime(buff, sizeof(buff), "%Y-%m-%dT%H:%M:%S", &tm);
+    return buff;
+}
+
+// Everything but the GL strings, which need a current context.
+inline BenchmarkMachine GetBenchmarkMachine()
+{
+    BenchmarkMachine m;
+    m.Host = GetHostName();
+    m.Os = GetOsName();
+    m.Cpu = GetCpuName();
+    m.Cores = (int)std::thread::hardware_concurrency();
+    m.Compiler = BENCHMARK_COMPILER;
+    m.Flags = BENCHMARK_CXX_FLAGS;
+    m.BuildType = BENCHMARK_BUILD_TYPE;
+    if (sizeof(ImDrawIdx) == 4)
+        m.BuildType += " idx32";
+    m.ImPlotVersion = IMPLOT_VERSION;
+    m.ImGuiVersion = IMGUI_VERSION;
+    if (!GetCommitHash(IMPLOT_DIR, m.ImPlotCommit))
+        m.ImPlotCommit = "unknown";
+    if (!GetCommitHash(IMGUI_DIR, m.ImGuiCommit))
+        m.ImGuiCommit = "unknown";
+    return m;
+}
@@ -0,0 +1,320 @@
+#pragma once
+
+#include <implot_internal.h>
+#include <json.hpp>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <string>
+#include <vector>
+#include "Helpers.h"
+#include "benchmark_stats.h"
+
+// Benchmark result types shared by the benchmark GUI and the CLI comparator.
+
+inline void MakeFitLine(const std::vector<float> &x, const std::vector<float> &y, ImVec2 line[2], float *m, float *b)
+{
+    ImTheilSen(x, y, m, b);
+    line[0].x = *std::min_element(x.begin(), x.end());
+    line[1].x = *std::max_element(x.begin(), x.end());
+    line[0].y = (*m) * line[0].x + (*b);
+    line[1].y = (*m) * line[1].x + (*b);
+}
+
+// Summary of one measured quantity over the steps of a benchmark run. Each step
+// keeps its raw trials; Median/Lo/Hi are computed after outlier rejection.
+struct BenchmarkStats
+{
+    void AddStep(const std::vector<float> &trials)
+    {
+        auto kept = ImRejectOutliers(trials);
+        float lo, hi;
+        ImMedianCI(kept, &lo, &hi);
+        Trials.push_back(trials);
+        Median.push_back(ImMedian(kept));
+        Lo.push_back(lo);
+        Hi.push_back(hi);
+    }
+    void FitData(const std::vector<float> &elems)
+    {
+        std::vector<float> x, y;
+        for (size_t i = 0; i < Trials.size(); ++i)
+        {
+            for (auto &t : ImRejectOutliers(Trials[i]))
+            {
+                x.push_back(elems[i]);
+                y.push_back(t);
+            }
+        }
+        if (x.size() > 1)
+            MakeFitLine(x, y, Fit, &M, &B);
+    }
+    std::vector<std::vector<float>> Trials;
+    std::vector<float> Median;
+    std::vector<float> Lo; // 95% CI of median
+    std::vector<float> Hi;
+    ImVec2 Fit[2];
+    float M = 0;
+    float B = 0;
+};
+
+struct BenchmarkRecord
+{
+    void AddRecord(int elems, const std::vector<float> &call, const std::vector<float> &frame, const std::vector<float> &fps)
+    {
+        Elems.push_back((float)elems);
+        Call.AddStep(call);
+        Frame.AddStep(frame);
+        Fps.AddStep(fps);
+    }
+    // memory footprint of the step just added with AddRecord
+    void AddMemory(const std::vector<float> &rss, const std::vector<float> &draw, const std::vector<float> &allocs)
+    {
+        RssGrowth.AddStep(rss);
+        DrawKB.AddStep(draw);
+        Allocs.AddStep(allocs);
+    }
+    // render timings of the step just added with AddRecord
+    void AddRender(const std::vector<float> &submit, const std::vector<float> &upload, const std::vector<float> &draw)
+    {
+        Submit.AddStep(submit);
+        Upload.AddStep(upload);
+        Draw.AddStep(draw);
+    }
+    void FitData()
+    {
+        Call.FitData(Elems);
+        Frame.FitData(Elems);
+        DrawKB.FitData(Elems);
+        Allocs.FitData(Elems);
+        Submit.FitData(Elems);
+        Upload.FitData(Elems);
+        Draw.FitData(Elems);
+    }
+    bool HasMemory() const { return DrawKB.Median.size() == Elems.size(); }
+    bool HasRssGrowth() const { return RssGrowth.Median.size() == Elems.size(); }
+    bool HasRender() const { return Submit.Median.size() == Elems.size(); }
+    std::vector<float> Elems;
+    BenchmarkStats Call;
+    BenchmarkStats Frame;
+    BenchmarkStats Fps;
+    BenchmarkStats RssGrowth; // current resident set (working set on Windows) minus the one before the run's first step, MB
+    BenchmarkStats DrawKB;    // draw list vertex and index bytes, KB
+    BenchmarkStats Allocs;    // ImGui heap allocations per frame
+    BenchmarkStats Submit;    // CPU time of RenderDrawData (and glFinish if enabled), ms
+    BenchmarkStats Upload;    // GPU time until the plot's draw list is uploaded, ms
+    BenchmarkStats Draw;      // GPU time of the plot's draw calls, ms
+};
+
+struct BenchmarkRecordCollection
+{
+    BenchmarkRecordCollection() : Col(RandomColor())
+    {
+    }
+    void SetColorFromString(const std::string &name)
+    {
+        Col = ImGui::ColorConvertU32ToFloat4(ImHashStr(name.c_str()));
+        Col.w = 1.0f;
+        ImGui::ColorConvertRGBtoHSV(Col.x, Col.y, Col.z, Col.x, Col.y, Col.z);
+        Col.z = ImRemap(Col.z, 0.0f, 1.0f, 0.25f, 1.0f);
+        ImGui::ColorConvertHSVtoRGB(Col.x, Col.y, Col.z, Col.x, Col.y, Col.z);
+    }
+    ImVec4 Col;
+    std::vector<BenchmarkRecord> Records;
+};
+
+// Machine and build a run was measured on (see benchmark_machine.h).
+struct BenchmarkMachine
+{
+    std::string Host;
+    std::string Os;
+    std::string Cpu;
+    int Cores = 0;
+    std::string Compiler;
+    std::string Flags;
+    std::string BuildType;
+    std::string ImPlotVersion;
+    std::string ImPlotCommit;
+    std::string ImGuiVersion;
+    std::string ImGuiCommit;
+    std::string Renderer;
+    std::string GlVersion;
+};
+
+// One completed benchmark run as appended to the run log.
+struct BenchmarkRunRecord
+{
+    std::string Date; // ISO 8601, local time
+    std::string Branch;
+    std::string Name;
+    BenchmarkMachine Machine;
+    BenchmarkRecord Record;
+};
+
+// Results are grouped by branch and host, so runs from different machines are
+// never merged into one collection.
+inline std::string BenchmarkGroupName(const BenchmarkRunRecord &run)
+{
+    return run.Branch + "@" + run.Machine.Host;
+}
+
+using json = nlohmann::json;
+
+NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(ImVec2, x, y);
+NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(ImVec4, x, y, z, w);
+NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(BenchmarkStats, Trials, Median, Lo, Hi, Fit, M, B);
+
+// memory and render stats are optional so that records saved before they existed
+// still load. Records saved with the process peak under "Rss" keep their draw
+// list and allocation stats but not the peak, which isn't comparable to RssGrowth.
+inline void to_json(json &j, const BenchmarkRecord &r)
+{
+    j = json{{"Elems", r.Elems}, {"Call", r.Call}, {"Frame", r.Frame}, {"Fps", r.Fps}};
+    if (r.HasMemory())
+    {
+        j["DrawKB"] = r.DrawKB;
+        j["Allocs"] = r.Allocs;
+    }
+    if (r.HasRssGrowth())
+        j["RssGrowth"] = r.RssGrowth;
+    if (r.HasRender())
+    {
+        j["Submit"] = r.Submit;
+        j["Upload"] = r.Upload;
+        j["Draw"] = r.Draw;
+    }
+}
+
+// Records written before trials were kept (benchmark.json from earlier
+// versions) hold one value per step in flat Call/Frame/Fps arrays, next to
+// Call_Fit/Call_M/Call_B etc. Each value becomes a step of a single trial and
+// the fits are recomputed.
+inline void LegacyStatsFromJson(const json &j, BenchmarkStats &s)
+{
+    for (float v : j.get<std::vector<float>>())
+        s.AddStep({v});
+}
+
+inline void from_json(const json &j, BenchmarkRecord &r)
+{
+    j.at("Elems").get_to(r.Elems);
+    if (j.at("Call").is_array())
+    {
+        LegacyStatsFromJson(j.at("Call"), r.Call);
+        LegacyStatsFromJson(j.at("Frame"), r.Frame);
+        LegacyStatsFromJson(j.at("Fps"), r.Fps);
+        r.FitData();
+        return;
+    }
+    j.at("Call").get_to(r.Call);
+    j.at("Frame").get_to(r.Frame);
+    j.at("Fps").get_to(r.Fps);
+    if (j.contains("DrawKB"))
+    {
+        j.at("DrawKB").get_to(r.DrawKB);
+        j.at("Allocs").get_to(r.Allocs);
+    }
+    if (j.contains("RssGrowth"))
+        j.at("RssGrowth").get_to(r.RssGrowth);
+    if (j.contains("Submit"))
+    {
+        j.at("Submit").get_to(r.Submit);
+        j.at("Upload").get_to(r.Upload);
+        j.at("Draw").get_to(r.Draw);
+    }
+}
+
+NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(BenchmarkRecordCollection, Col, Records);
+NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(BenchmarkMachine, Host, Os, Cpu, Cores, Compiler, Flags, BuildType, ImPlotVersion, ImPlotCommit, ImGuiVersion, ImGuiCommit, Renderer, GlVersion);
+NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(BenchmarkRunRecord, Date, Branch, Name, Machine, Record);
+
+// branch -> run name -> collection
+typedef std::map<std::string, BenchmarkRecordCollection> BenchmarkRecordSet;
+typedef std::map<std::string, BenchmarkRecordSet> BenchmarkRecordMap;
+
+inline bool LoadBenchmarkRecords(const std::string &path, BenchmarkRecordMap &records)
+{
+    std::ifstream file(path);
+    if (!file.is_open())
+        return false;
+    try
+    {
+        json j;
+        file >> j;
+        j.at("records").get_to(records);
+    }
+    catch (const json::exception &e)
+    {
+        // the file itself is left as is, it is never written back
+        printf("Could not read %s, its results are not shown (%s)\n", path.c_str(), e.what());
+        records.clear();
+        return false;
+    }
+    return true;
+}
+
+inline bool SaveBenchmarkRecords(const std::string &path, const BenchmarkRecordMap &records)
+{
+    json j;
+    j["records"] = records;
+    std::ofstream file(path);
+    if (!file.is_open())
+        return false;
+    file << std::setw(4) << j;
+    return true;
+}
+
+// The run log is a JSON Lines file with one BenchmarkRunRecord per line. Runs
+// are only ever appended, so results from earlier sessions, branches and
+// machines are never overwritten.
+inline bool LoadBenchmarkRuns(const std::string &path, std::vector<BenchmarkRunRecord> &runs)
+{
+    std::ifstream file(path);
+    if (!file.is_open())
+        return false;
+    std::string line;
+    for (int n = 1; std::getline(file, line); ++n)
+    {
+        if (line.empty())
+            continue;
+        try
+        {
+            runs.push_back(json::parse(line).get<BenchmarkRunRecord>());
+        }
+        catch (const json::exception &e)
+        {
+            printf("Skipping line %d of %s (%s)\n", n, path.c_str(), e.what());
+        }
+    }
+    return true;
+}
+
+inline bool AppendBenchmarkRun(const std::string &path, const BenchmarkRunRecord &run)
+{
+    std::ofstream file(path, std::ios::app);
+    if (!file.is_open())
+        return false;
+    file << json(run).dump() << "\n";
+    return true;
+}
+
+inline void AddBenchmarkRun(BenchmarkRecordMap &records, const BenchmarkRunRecord &run)
+{
+    auto &collection = records[BenchmarkGroupName(run)][run.Name];
+    collection.Records.push_back(run.Record);
+    collection.SetColorFromString(run.Name);
+}
+
+// Loads either a run log (.jsonl) or a legacy benchmark.json map, including
+// files written before trials were recorded (see LegacyStatsFromJson).
+inline bool LoadBenchmarkFile(const std::string &path, BenchmarkRecordMap &records)
+{
+    if (path.size() < 6 || path.compare(path.size() - 6, 6, ".jsonl") != 0)
+        return LoadBenchmarkRecords(path, records);
+    std::vector<BenchmarkRunRecord> runs;
+    if (!LoadBenchmarkRuns(path, runs))
+        return false;
+    for (auto &run : runs)
+        AddBenchmarkRun(records, run);
+    return true;
+}
@@ -0,0 +1,192 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+// Small set of robust statistics used by the benchmark tools. Everything here
+// operates on plain vectors so it can be shared by the GUI and CLI tools.
+
+template <typename T>
+inline T ImMedian(std::vector<T> values)
+{
+    if (values.empty())
+        return 0;
+    const size_t n = values.size();
+    std::nth_element(values.begin(), values.begin() + n / 2, values.end());
+    T hi = values[n / 2];
+    if (n % 2 == 1)
+        return hi;
+    T lo = *std::max_element(values.begin(), values.begin() + n / 2);
+    return (lo + hi) / 2;
+}
+
+// median absolute deviation
+template <typename T>
+inline T ImMedianAbsDev(const std::vector<T> &values, T median)
+{
+    std::vector<T> dev(values.size());
+    for (size_t i = 0; i < values.size(); ++i)
+        dev[i] = std::abs(values[i] - median);
+    return ImMedian(dev);
+}
+
+// Removes values whose modified z-score exceeds 3.5 (Iglewicz and Hoaglin). The
+// MAD is scaled by 1.4826 so that it estimates sigma for normal data.
+template <typename T>
+inline std::vector<T> ImRejectOutliers(const std::vector<T> &values, double z = 3.5)
+{
+    if (values.size() < 3)
+        return values;
+    const T med = ImMedian(values);
+    const double mad = 1.4826 * ImMedianAbsDev(values, med);
+    if (mad <= 0)
+        return values;
+    std::vector<T> kept;
+    kept.reserve(values.size());
+    for (auto &v : values)
+    {
+        if (std::abs(v - med) / mad <= z)
+            kept.push_back(v);
+    }
+    return kept;
+}
+
+template <typename T>
+inline double ImMeanOf(const std::vector<T> &values)
+{
+    if (values.empty())
+        return 0;
+    double sum = 0;
+    for (auto &v : values)
+        sum += v;
+    return sum / values.size();
+}
+
+template <typename T>
+inline double ImVarianceOf(const std::vector<T> &values)
+{
+    if (values.size() < 2)
+        return 0;
+    const double mean = ImMeanOf(values);
+    double ss = 0;
+    for (auto &v : values)
+        ss += (v - mean) * (v - mean);
+    return ss / (values.size() - 1);
+}
+
+// Distribution-free confidence interval for the median from order statistics.
+// Picks the widest rank k such that [x_(k), x_(n-k+1)] still covers the median
+// with at least the requested confidence. Falls back to [min,max] when there are
+// too few samples to reach it.
+template <typename T>
+inline void ImMedianCI(std::vector<T> values, T *lo, T *hi, double confidence = 0.95)
+{
+    if (values.empty())
+    {
+        *lo = *hi = 0;
+        return;
+    }
+    std::sort(values.begin(), values.end());
+    const int n = (int)values.size();
+    const double alpha2 = (1.0 - confidence) / 2;
+    // cumulative Binomial(n, 0.5)
+    double pmf = std::pow(0.5, n);
+    double cdf = pmf;
+    int k = 0;
+    for (int j = 0; j < n / 2; ++j)
+    {
+        if (cdf > alpha2)
+            break;
+        k = j + 1;
+        pmf *= (double)(n - j) / (j + 1);
+        cdf += pmf;
+    }
+    k = std::max(k, 1);
+    *lo = values[k - 1];
+    *hi = values[n - k];
+}
+
+// Theil-Sen estimator: slope is the median of all pairwise slopes, intercept is
+// the median of the residuals. Breakdown point of ~29%, so a few bad steps do not
+// drag the fit the way least squares does.
+template <typename T>
+inline void ImTheilSen(const std::vector<T> &x, const std::vector<T> &y, T *mOut, T *bOut)
+{
+    const size_t n = std::min(x.size(), y.size());
+    std::vector<T> slopes;
+    slopes.reserve(n * (n - 1) / 2);
+    for (size_t i = 0; i < n; ++i)
+    {
+        for (size_t j = i + 1; j < n; ++j)
+        {
+            if (x[j] != x[i])
+                slopes.push_back((y[j] - y[i]) / (x[j] - x[i]));
+        }
+    }
+    *mOut = ImMedian(slopes);
+    std::vector<T> resid(n);
+    for (size_t i = 0; i < n; ++i)
+        resid[i] = y[i] - *mOut * x[i];
+    *bOut = ImMedian(resid);
+}
+
+// Regularized incomplete beta function I_x(a,b) by Lentz's continued fraction.
+inline double ImIncompleteBeta(double a, double b, double x)
+{
+    if (x <= 0)
+        return 0;
+    if (x >= 1)
+        return 1;
+    // the continued fraction converges quickly only for x < (a+1)/(a+b+2)
+    if (x > (a + 1) / (a + b + 2))
+        return 1 - ImIncompleteBeta(b, a, 1 - x);
+    const double tiny = 1e-300;
+    const double lbeta = std::lgamma(a + b) - std::lgamma(a) - std::lgamma(b);
+    const double front = std::exp(std::log(x) * a + std::log(1 - x) * b + lbeta) / a;
+    double f = 1, c = 1, d = 0;
+    for (int i = 0; i <= 200; ++i)
+    {
+        const int m = i / 2;
+        double num;
+        if (i == 0)
+            num = 1;
+        else if (i % 2 == 0)
+            num = (m * (b - m) * x) / ((a + 2 * m - 1) * (a + 2 * m));
+        else
+            num = -((a + m) * (a + b + m) * x) / ((a + 2 * m) * (a + 2 * m + 1));
+        d = 1 + num * d;
+        d = std::abs(d) < tiny ? tiny : d;
+        d = 1 / d;
+        c = 1 + num / c;
+        c = std::abs(c) < tiny ? tiny : c;
+        const double cd = c * d;
+        f *= cd;
+        if (std::abs(1 - cd) < 1e-10)
+            break;
+    }
+    return front * (f - 1);
+}
+
+// Two-sided p-value of Student's t distribution with df degrees of freedom.
+inline double ImStudentTPValue(double t, double df)
+{
+    return ImIncompleteBeta(df / 2, 0.5, df / (df + t * t));
+}
+
+// Welch's unequal variance t-test. Returns the two-sided p-value for the null
+// hypothesis that a and b have the same mean; 1 if either side has < 2 samples.
+template <typename T>
+inline double ImWelchTTest(const std::vector<T> &a, const std::vector<T> &b)
+{
+    if (a.size() < 2 || b.size() < 2)
+        return 1;
+    const double va = ImVarianceOf(a) / a.size();
+    const double vb = ImVarianceOf(b) / b.size();
+    const double diff = ImMeanOf(a) - ImMeanOf(b);
+    if (va + vb <= 0)
+        return diff == 0 ? 1 : 0;
+    const double t = diff / std::sqrt(va + vb);
+    const double df = (va + vb) * (va + vb) / (va * va / (a.size() - 1) + vb * vb / (b.size() - 1));
+    return ImStudentTPValue(t, df);
+}
@@ -0,0 +1,468 @@
+// Microbenchmark for the CPU side of the plot kernels. Unlike the benchmark
+// tool no window or GL context is created: ImGui runs headless and each sample
+// is a single kernel call into a fresh plot, so only data transform, culling and
+// vertex emission are timed. Reports ns/point, GB/s (data read + vertices and
+// indices written) and vertices emitted for every kernel, type and size:
+//
+//   microbench                       all kernels, types and sizes
+//   microbench -f Inline -r 50       kernels matching "Inline", 50 samples each
+//   microbench -f _double -m 10000   double data, up to 10000 points
+//   microbench -d NaNGaps10          run against one of the benchmark datasets
+//   microbench -f Line -d NaNGaps50  line kernels breaking at NaN gaps (NaNGaps1/10/50 vs Noise)
+//   microbench -z 100                only the middle 1% of the data visible
+//   microbench -s Log10              log scaled x axis (kernels specialize on the scale)
+//   microbench -f Spec -m 10         per item styling cost with ImPlotSpec (vs -f SetNext)
+//   microbench -f InlineThreaded     vertex generation split across cores
+//   microbench --threads             scaling of the threaded kernels, 1, 2, 4, ... threads
+//   microbench -f Scrolling          ring buffer transforming only new samples
+//   microbench -f Line --noaa        line kernels without the baked AA line texture
+//   microbench --check -d Timestamps line vertices vs a double transform at ~1.6e9 x
+//
+// Indices are 16-bit unless built with -DIMGUI_32BIT_INDICES=ON; compare the two
+// builds to see what splitting large items into 64K vertex draw commands costs.
+
+#include "plot_line_inline.h"
+#include "plot_line_pyramid.h"
+#include "plot_scrolling.h"
+#include "plot_spec.h"
+#include "plot_staging.h"
+#include "benchmark_stats.h"
+#include "benchmark_data.h"
+#include "cxxopts.hpp"
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+static constexpr int kMaxPoints = 1000000;
+static constexpr int kWarmupSamples = 3;
+static constexpr float kCheckMaxError = 0.25f; // px, for --check
+static const int kSizes[] = {10, 1000, 10000, 100000, 1000000};
+static const char *kTypeNames[] = {"int", "float", "double"};
+
+template <typename T>
+struct MicroData
+{
+    MicroData(BenchmarkDataset set) : Xs(kMaxPoints), Ys(kMaxPoints)
+    {
+        GenerateBenchmarkData(set, Xs.data(), Ys.data(), kMaxPoints, kMaxPoints, 0, 1000);
+    }
+    std::vector<T> Xs;
+    std::vector<T> Ys;
+};
+
+struct MicroKernel
+{
+    const char *Name;
+    void (*Int)(const char *, const int *, const int *, int);
+    void (*Float)(const char *, const float *, const float *, int);
+    void (*Double)(const char *, const double *, const double *, int);
+    bool Polyline; // one quad per segment in data order, so --check can read it back
+};
+
+#define MICRO_KERNEL(NAME, FUNC, POLYLINE)                                                 \
+    {                                                                                      \
+        NAME,                                                                              \
+        [](const char *l, const int *x, const int *y, int n) { FUNC(l, x, y, n); },        \
+        [](const char *l, const float *x, const float *y, int n) { FUNC(l, x, y, n); },    \
+        [](const char *l, const double *x, const double *y, int n) { FUNC(l, x, y, n); }, \
+        POLYLINE                                                                           \
+    }
+
+// binary search culling, wrong output for -d NonMonotonic
+template <typename T>
+static void PlotLineInlineSorted(const char *label_id, const T *xs, const T *ys, int count)
+{
+    ImPlot::PlotLineInline(label_id, xs, ys, count, ImPlotInlineFlags_SortedX);
+}
+
+// ys only, x is taken as the index; the pyramid is built during warmup
+template <typename T>
+static void PlotLinePyramid(const char *label_id, const T *, const T *ys, int count)
+{
+    ImPlot::PlotLinePyramid(label_id, ys, count);
+}
+
+template <typename T>
+static void PlotLineInlineScalar(const char *label_id, const T *xs, const T *ys, int count)
+{
+    ImPlot::PlotLineInline(label_id, xs, ys, count, ImPlotInlineFlags_NoSimd);
+}
+
+template <typename T>
+static void PlotLineInlineThreaded(const char *label_id, const T *xs, const T *ys, int count)
+{
+    ImPlot::PlotLineInline(label_id, xs, ys, count, ImPlotInlineFlags_Threaded);
+}
+
+// A scrolling buffer of count samples, filled on the first call; every call
+// after that appends 16 more (the data again, in order) over the oldest, so
+// only those are transformed. Compare with PlotLineStaged, which transforms all.
+template <typename T>
+static void PlotLineScrolling(const char *label_id, const T *xs, const T *ys, int count)
+{
+    static constexpr int kAppend = 16;
+    static std::unordered_map<int, ImPlot::PlotScrollingBuffer<T>> buffers;
+    ImPlot::PlotScrollingBuffer<T> &buf = buffers.try_emplace(count, count).first->second;
+    const int appends = buf.Size() < count ? count : kAppend;
+    for (int k = 0; k < appends; ++k)
+    {
+        const int i = (int)(buf.Added % count);
+        buf.AddPoint(xs[i], ys[i]);
+    }
+    ImPlot::PlotLineScrolling(label_id, buf);
+}
+
+// per item styling through SetNext* calls or an inline ImPlotSpec, with
+// otherwise identical PlotLine calls
+static const ImVec4 kMicroColor(0.2f, 0.4f, 0.8f, 1.0f);
+
+template <typename T>
+static void PlotLineSetNext(const char *label_id, const T *xs, const T *ys, int count)
+{
+    ImPlot::SetNextLineStyle(kMicroColor, 2.0f);
+    ImPlot::SetNextFillStyle(kMicroColor);
+    ImPlot::PlotLine(label_id, xs, ys, count);
+}
+
+template <typename T>
+static void PlotLineSpec(const char *label_id, const T *xs, const T *ys, int count)
+{
+    ImPlot::PlotLine(label_id, xs, ys, count, ImPlotSpec_LineColor, kMicroColor, ImPlotSpec_LineWeight, 2.0f, ImPlotSpec_FaceColor, kMicroColor);
+}
+
+// the same data through the offset (wrapped ring buffer) and getter paths
+template <typename T>
+static void PlotLineOffset(const char *label_id, const T *xs, const T *ys, int count)
+{
+    ImPlot::PlotLine(label_id, xs, ys, count, 0, count / 2);
+}
+
+template <typename T>
+struct MicroArrays
+{
+    static ImPlotPoint Getter(int idx, void *data)
+    {
+        auto &self = *(MicroArrays *)data;
+        return ImPlotPoint(self.Xs[idx], self.Ys[idx]);
+    }
+    const T *Xs;
+    const T *Ys;
+};
+
+template <typename T>
+static void PlotLineGetter(const char *label_id, const T *xs, const T *ys, int count)
+{
+    MicroArrays<T> arrays{xs, ys};
+    ImPlot::PlotLineG(label_id, MicroArrays<T>::Getter, &arrays, count);
+}
+
+// standard items and their staged versions (plot_staging.h)
+template <typename T>
+static void PlotBars(const char *label_id, const T *xs, const T *ys, int count)
+{
+    ImPlot::PlotBars(label_id, xs, ys, count, 0.8);
+}
+
+template <typename T>
+static void PlotBarsStaged(const char *label_id, const T *xs, const T *ys, int count)
+{
+    ImPlot::PlotBarsStaged(label_id, xs, ys, count, 0.8);
+}
+
+static const MicroKernel kKernels[] = {
+    MICRO_KERNEL("PlotLine", ImPlot::PlotLine, true),
+    MICRO_KERNEL("PlotLineInline", ImPlot::PlotLineInline, true),
+    MICRO_KERNEL("PlotLineInlineScalar", PlotLineInlineScalar, true),
+    MICRO_KERNEL("PlotLineInlineSorted", PlotLineInlineSorted, true),
+    MICRO_KERNEL("PlotLineInlineThreaded", PlotLineInlineThreaded, true),
+    MICRO_KERNEL("PlotLineStaged", ImPlot::PlotLineStaged, true),
+    MICRO_KERNEL("PlotLineM4", ImPlot::PlotLineM4, false),
+    MICRO_KERNEL("PlotLinePyramid", PlotLinePyramid, false),
+    MICRO_KERNEL("PlotLineScrolling", PlotLineScrolling, false),
+    MICRO_KERNEL("PlotLineSetNext", PlotLineSetNext, true),
+    MICRO_KERNEL("PlotLineSpec", PlotLineSpec, true),
+    MICRO_KERNEL("PlotLineOffset", PlotLineOffset, false),
+    MICRO_KERNEL("PlotLineGetter", PlotLineGetter, true),
+    MICRO_KERNEL("PlotScatter", ImPlot::PlotScatter, false),
+    MICRO_KERNEL("PlotScatterStaged", ImPlot::PlotScatterStaged, false),
+    MICRO_KERNEL("PlotBars", PlotBars, false),
+    MICRO_KERNEL("PlotBarsStaged", PlotBarsStaged, false),
+    MICRO_KERNEL("PlotShaded", ImPlot::PlotShaded, false),
+    MICRO_KERNEL("PlotShadedStaged", ImPlot::PlotShadedStaged, false),
+    MICRO_KERNEL("PlotStairs", ImPlot::PlotStairs, false),
+    MICRO_KERNEL("PlotStairsStaged", ImPlot::PlotStairsStaged, false),
+};
+
+// Headless ImGui/ImPlot context with a single full screen plot per frame.
+struct MicroContext
+{
+    MicroContext(bool aa, ImPlotScale x_scale) : XScale(x_scale)
+    {
+        ImGui::CreateContext();
+        ImPlot::CreateContext();
+        ImGuiIO &io = ImGui::GetIO();
+        io.IniFilename = NULL;
+        io.DisplaySize = ImVec2(1920, 1080);
+        io.DeltaTime = 1.0f / 60.0f;
+        io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;
+        unsigned char *pixels;
+        int w, h;
+        io.Fonts->GetTexDataAsRGBA32(&pixels, &w, &h);
+        ImGui::GetStyle().AntiAliasedLines = ImGui::GetStyle().AntiAliasedLinesUseTex = aa;
+    }
+    ~MicroContext()
+    {
+        ImPlot::DestroyContext();
+        ImGui::DestroyContext();
+    }
+    ImDrawList &BeginFrame(double x_min, double x_max, double y_min, double y_max)
+    {
+        ImGui::NewFrame();
+        ImGui::SetNextWindowPos(ImVec2(0, 0), ImGuiCond_Always);
+        ImGui::SetNextWindowSize(ImGui::GetIO().DisplaySize, ImGuiCond_Always);
+        ImGui::Begin("##MicroBench", NULL, ImGuiWindowFlags_NoDecoration);
+        ImPlot::BeginPlot("##MicroBench", ImVec2(-1, -1), ImPlotFlags_CanvasOnly);
+        ImPlot::SetupAxesLimits(x_min, x_max, y_min, y_max, ImGuiCond_Always);
+        ImPlot::SetupAxes(NULL, NULL, ImPlotAxisFlags_NoDecorations, ImPlotAxisFlags_NoDecorations);
+        ImPlot::SetupAxisScale(ImAxis_X1, XScale);
+        ImPlot::SetupFinish();
+        return *ImPlot::GetPlotDrawList();
+    }
+    void EndFrame()
+    {
+        ImPlot::EndPlot();
+        ImGui::End();
+        ImGui::EndFrame();
+    }
+    ImPlotScale XScale;
+};
+
+struct MicroResult
+{
+    double Ns = 0, Lo = 0, Hi = 0; // median and CI of one call, ns
+    size_t BytesIn = 0, BytesOut = 0;
+    int Vertices = 0; // emitted by one call
+};
+
+// x limits of the plot for count points of set, zoomed around their center
+static void MicroXLimits(BenchmarkDataset set, int count, double zoom, double *x_min, double *x_max)
+{
+    BenchmarkDatasetXLimits(set, count, x_min, x_max);
+    const double x_mid = (*x_min + *x_max) / 2;
+    const double x_half = (*x_max - *x_min) / 2 / zoom;
+    *x_min = x_mid - x_half;
+    *x_max = x_mid + x_half;
+}
+
+template <typename T>
+static MicroResult RunKernel(MicroContext &ctx, void (*kernel)(const char *, const T *, const T *, int), const MicroData<T> &data, BenchmarkDataset set, double zoom, int count, int reps)
+{
+    MicroResult res;
+    std::vector<double> samples;
+    double x_min, x_max;
+    MicroXLimits(set, count, zoom, &x_min, &x_max);
+    for (int r = -kWarmupSamples; r < reps; ++r)
+    {
+        ImDrawList &draw_list = ctx.BeginFrame(x_min, x_max, -1200, 1200);
+        const int vtx0 = draw_list.VtxBuffer.Size;
+        const int idx0 = draw_list.IdxBuffer.Size;
+        auto t1 = Clock::now();
+        kernel("##Kernel", data.Xs.data(), data.Ys.data(), count);
+        auto t2 = Clock::now();
+        res.Vertices = draw_list.VtxBuffer.Size - vtx0;
+        res.BytesOut = (draw_list.VtxBuffer.Size - vtx0) * sizeof(ImDrawVert) + (draw_list.IdxBuffer.Size - idx0) * sizeof(ImDrawIdx);
+        ctx.EndFrame();
+        if (r >= 0)
+            samples.push_back(std::chrono::duration<double, std::nano>(t2 - t1).count());
+    }
+    res.BytesIn = 2 * count * sizeof(T);
+    res.Ns = ImMedian(samples);
+    ImMedianCI(samples, &res.Lo, &res.Hi);
+    return res;
+}
+
+// Largest distance in pixels between a segment end of the kernel's quads (the
+// midpoint of the quad's end edge) and the point transformed by PlotToPixels,
+// which works in double. -1 if the kernel did not emit one quad per segment,
+// e.g. because some were culled.
+template <typename T>
+static float CheckKernel(MicroContext &ctx, void (*kernel)(const char *, const T *, const T *, int), const MicroData<T> &data, BenchmarkDataset set, double zoom, int count)
+{
+    double x_min, x_max;
+    MicroXLimits(set, count, zoom, &x_min, &x_max);
+    ImDrawList &draw_list = ctx.BeginFrame(x_min, x_max, -1200, 1200);
+    const int vtx0 = draw_list.VtxBuffer.Size;
+    kernel("##Kernel", data.Xs.data(), data.Ys.data(), count);
+    float err = -1;
+    if (draw_list.VtxBuffer.Size - vtx0 == 4 * (count - 1))
+    {
+        err = 0;
+        for (int i = 0; i + 1 < count; ++i)
+        {
+            const ImDrawVert *v = &draw_list.VtxBuffer[vtx0 + 4 * i];
+            const ImVec2 p1 = ImPlot::PlotToPixels(ImPlotPoint((double)data.Xs[i], (double)data.Ys[i]));
+            const ImVec2 p2 = ImPlot::PlotToPixels(ImPlotPoint((double)data.Xs[i + 1], (double)data.Ys[i + 1]));
+            err = ImMax(err, ImMax(ImFabs((v[0].pos.x + v[3].pos.x) * 0.5f - p1.x), ImFabs((v[0].pos.y + v[3].pos.y) * 0.5f - p1.y)));
+            err = ImMax(err, ImMax(ImFabs((v[1].pos.x + v[2].pos.x) * 0.5f - p2.x), ImFabs((v[1].pos.y + v[2].pos.y) * 0.5f - p2.y)));
+        }
+    }
+    ctx.EndFrame();
+    return err;
+}
+
+int main(int argc, char const *argv[])
+{
+    cxxopts::Options options("microbench", "Headless microbenchmark of ImPlot line kernels");
+    options.add_options()
+        ("f,filter", "Only run kernels whose <kernel>_<type> name contains this", cxxopts::value<std::string>()->default_value(""))
+        ("r,reps", "Samples per kernel, type and size", cxxopts::value<int>()->default_value("25"))
+        ("m,max", "Largest point count to run", cxxopts::value<int>()->default_value(std::to_string(kMaxPoints)))
+        ("d,data", "Dataset (Noise, RandomWalk, Sinusoid, Spikes, NaNGaps1, NaNGaps10, NaNGaps50, NonMonotonic, Timestamps, Offscreen)", cxxopts::value<std::string>()->default_value("Noise"))
+        ("z,zoom", "Zoom on x around the center of the data", cxxopts::value<double>()->default_value("1"))
+        ("s,scale", "X axis scale (Linear, Time, Log10, SymLog)", cxxopts::value<std::string>()->default_value("Linear"))
+        ("noaa", "Disable anti-aliased lines")
+        ("check", "Instead of timing, check the line kernels' vertex positions against a double precision transform")
+        ("threads", "Instead of the table, time the Threaded kernels (or those matching -f) at the largest size with 1, 2, 4, ... threads")
+        ("help", "Print usage");
+    auto result = options.parse(argc, argv);
+    if (result.count("help"))
+    {
+        printf("%s\n", options.help().c_str());
+        return 0;
+    }
+    const std::string filter = result["filter"].as<std::string>();
+    const int reps = std::max(1, result["reps"].as<int>());
+    const int max_points = result["max"].as<int>();
+    const double zoom = std::max(1.0, result["zoom"].as<double>());
+    const std::string data_name = result["data"].as<std::string>();
+    int set = 0;
+    while (set < BenchmarkDataset_COUNT && data_name != BenchmarkDataset_Names[set])
+        ++set;
+    if (set == BenchmarkDataset_COUNT)
+    {
+        fprintf(stderr, "unknown dataset '%s'\n", data_name.c_str());
+        return 2;
+    }
+
+    static const char *kScaleNames[] = {"Linear", "Time", "Log10", "SymLog"};
+    const std::string scale_name = result["scale"].as<std::string>();
+    int scale = 0;
+    while (scale < IM_ARRAYSIZE(kScaleNames) && scale_name != kScaleNames[scale])
+        ++scale;
+    if (scale == IM_ARRAYSIZE(kScaleNames))
+    {
+        fprintf(stderr, "unknown scale '%s'\n", scale_name.c_str());
+        return 2;
+    }
+
+    MicroContext ctx(!result.count("noaa"), scale);
+    MicroData<int> data_int((BenchmarkDataset)set);
+    MicroData<float> data_float((BenchmarkDataset)set);
+    MicroData<double> data_double((BenchmarkDataset)set);
+
+    if (result.count("check"))
+    {
+        int failed = 0;
+        printf("%-28s %10s %12s\n", "kernel", "points", "max err px");
+        for (auto &kernel : kKernels)
+        {
+            for (int t = 0; t < 3; ++t)
+            {
+                const std::string name = std::string(kernel.Name) + "_" + kTypeNames[t];
+                if (!kernel.Polyline || name.find(filter) == std::string::npos)
+                    continue;
+                for (int count : kSizes)
+                {
+                    if (count > max_points)
+                        continue;
+                    float err;
+                    if (t == 0)
+                        err = CheckKernel(ctx, kernel.Int, data_int, (BenchmarkDataset)set, zoom, count);
+                    else if (t == 1)
+                        err = CheckKernel(ctx, kernel.Float, data_float, (BenchmarkDataset)set, zoom, count);
+                    else
+                        err = CheckKernel(ctx, kernel.Double, data_double, (BenchmarkDataset)set, zoom, count);
+                    if (err < 0)
+                        printf("%-28s %10d %12s\n", name.c_str(), count, "culled");
+                    else
+                        printf("%-28s %10d %12.4f%s\n", name.c_str(), count, err, err > kCheckMaxError ? "  FAIL" : "");
+                    failed += err > kCheckMaxError;
+                }
+            }
+        }
+        return failed > 0 ? 1 : 0;
+    }
+
+    printf("ImDrawIdx: %d-bit, %d threads\n", (int)sizeof(ImDrawIdx) * 8, ImPlot::PlotThreadCount());
+    if (result.count("threads"))
+    {
+        // largest size run, at every power of two threads and all of them
+        int count = 0;
+        for (int c : kSizes)
+            count = c <= max_points ? c : count;
+        std::vector<int> thread_counts;
+        for (int n = 1; n < ImPlot::PlotThreadCount(); n *= 2)
+            thread_counts.push_back(n);
+        thread_counts.push_back(ImPlot::PlotThreadCount());
+        const std::string sweep_filter = filter.empty() ? "Threaded" : filter;
+        printf("%-28s %10s %8s %10s %21s %8s\n", "kernel", "points", "threads", "ns/pt", "95% CI", "speedup");
+        for (auto &kernel : kKernels)
+        {
+            for (int t = 0; t < 3; ++t)
+            {
+                const std::string name = std::string(kernel.Name) + "_" + kTypeNames[t];
+                if (name.find(sweep_filter) == std::string::npos)
+                    continue;
+                double ns1 = 0;
+                for (int threads : thread_counts)
+                {
+                    ImPlot::PlotThreadLimit() = threads;
+                    MicroResult res;
+                    if (t == 0)
+                        res = RunKernel(ctx, kernel.Int, data_int, (BenchmarkDataset)set, zoom, count, reps);
+                    else if (t == 1)
+                        res = RunKernel(ctx, kernel.Float, data_float, (BenchmarkDataset)set, zoom, count, reps);
+                    else
+                        res = RunKernel(ctx, kernel.Double, data_double, (BenchmarkDataset)set, zoom, count, reps);
+                    ns1 = threads == 1 ? res.Ns : ns1;
+                    printf("%-28s %10d %8d %10.3f [%8.3f, %8.3f] %8.2f\n", name.c_str(), count, threads, res.Ns / count, res.Lo / count, res.Hi / count,
+                           res.Ns > 0 ? ns1 / res.Ns : 0.0);
+                }
+                ImPlot::PlotThreadLimit() = 0;
+            }
+        }
+        return 0;
+    }
+
+    printf("%-28s %10s %10s %21s %8s %10s\n", "kernel", "points", "ns/pt", "95% CI", "GB/s", "vertices");
+    for (auto &kernel : kKernels)
+    {
+        for (int t = 0; t < 3; ++t)
+        {
+            const std::string name = std::string(kernel.Name) + "_" + kTypeNames[t];
+            if (name.find(filter) == std::string::npos)
+                continue;
+            for (int count : kSizes)
+            {
+                if (count > max_points)
+                    continue;
+                MicroResult res;
+                if (t == 0)
+                    res = RunKernel(ctx, kernel.Int, data_int, (BenchmarkDataset)set, zoom, count, reps);
+                else if (t == 1)
+                    res = RunKernel(ctx, kernel.Float, data_float, (BenchmarkDataset)set, zoom, count, reps);
+                else
+                    res = RunKernel(ctx, kernel.Double, data_double, (BenchmarkDataset)set, zoom, count, reps);
+                printf("%-28s %10d %10.3f [%8.3f, %8.3f] %8.2f %10d\n", name.c_str(), count, res.Ns / count, res.Lo / count, res.Hi / count,
+                       res.Ns > 0 ? (res.BytesIn + res.BytesOut) / res.Ns : 0.0, res.Vertices);
+            }
+        }
+    }
+    if (ImPlot::PlotPyramidMemory() > 0)
+        printf("pyramid cache: %.2f MB\n", ImPlot::PlotPyramidMemory() / 1e6);
+    return 0;
+}
@@ -1,4 +1,10 @@
+#pragma once
+
 #include <implot_internal.h>
+#include "plot_threads.h"
+#include <algorithm>
+#include <cfloat>
+#include <type_traits>
 
 #if defined __SSE__ || defined __x86_64__ || defined _M_X64
 static inline float ImInvSqrt(float x) { return _mm_cvtss_f32(_mm_rsqrt_ss(_mm_set_ss(x))); }
@@ -18,163 +24,792 @@ static inline float ImInvSqrt(float x) { return 1.0f / sqrtf(x); }
         }                                    \
     } while (0)
 
+// AVX2 line emitter. The kernel is compiled for AVX2 with a target attribute
+// (no -mavx2 needed for the rest of the file) and selected at runtime from cpuid.
+#if (defined __x86_64__ || defined _M_X64) && !defined IMGUI_OVERRIDE_DRAWVERT_STRUCT_LAYOUT
+#define IMPLOT_LINE_AVX2
+#include <immintrin.h>
+#if defined _MSC_VER
+#include <intrin.h>
+#define IMPLOT_AVX2_TARGET
+#else
+#define IMPLOT_AVX2_TARGET __attribute__((target("avx2")))
+#endif
+#endif
+
+typedef int ImPlotInlineFlags;
+enum ImPlotInlineFlags_
+{
+    ImPlotInlineFlags_None = 0,
+    ImPlotInlineFlags_NoSimd = 1 << 0,  // always use the scalar loop, e.g. to benchmark it
+    ImPlotInlineFlags_SortedX = 1 << 1, // xs is monotonic increasing (see IsSortedX), cull by binary search
+    ImPlotInlineFlags_Threaded = 1 << 2, // split large items across the plot thread pool
+};
+
 namespace ImPlot
 {
-    template <typename T>
-    void PlotLineInline(const char *label_id, const T *xs, const T *ys, int count)
+    // Writes the quad of one line segment given its four corners: a, b on one
+    // side of the line with uv0 and c, d on the other with uv1.
+    static inline void PrimLineQuad(ImDrawList &DrawList, float ax, float ay, float bx, float by, float cx, float cy, float dx, float dy, const ImVec2 &uv0, const ImVec2 &uv1, ImU32 col)
     {
-        ImPlotContext &gp = *GImPlot;
-        if (BeginItem(label_id, ImPlotCol_Line))
+        DrawList._VtxWritePtr[0].pos.x = ax;
+        DrawList._VtxWritePtr[0].pos.y = ay;
+        DrawList._VtxWritePtr[0].uv = uv0;
+        DrawList._VtxWritePtr[0].col = col;
+        DrawList._VtxWritePtr[1].pos.x = bx;
+        DrawList._VtxWritePtr[1].pos.y = by;
+        DrawList._VtxWritePtr[1].uv = uv0;
+        DrawList._VtxWritePtr[1].col = col;
+        DrawList._VtxWritePtr[2].pos.x = cx;
+        DrawList._VtxWritePtr[2].pos.y = cy;
+        DrawList._VtxWritePtr[2].uv = uv1;
+        DrawList._VtxWritePtr[2].col = col;
+        DrawList._VtxWritePtr[3].pos.x = dx;
+        DrawList._VtxWritePtr[3].pos.y = dy;
+        DrawList._VtxWritePtr[3].uv = uv1;
+        DrawList._VtxWritePtr[3].col = col;
+        DrawList._VtxWritePtr += 4;
+        DrawList._IdxWritePtr[0] = (ImDrawIdx)(DrawList._VtxCurrentIdx);
+        DrawList._IdxWritePtr[1] = (ImDrawIdx)(DrawList._VtxCurrentIdx + 1);
+        DrawList._IdxWritePtr[2] = (ImDrawIdx)(DrawList._VtxCurrentIdx + 2);
+        DrawList._IdxWritePtr[3] = (ImDrawIdx)(DrawList._VtxCurrentIdx);
+        DrawList._IdxWritePtr[4] = (ImDrawIdx)(DrawList._VtxCurrentIdx + 2);
+        DrawList._IdxWritePtr[5] = (ImDrawIdx)(DrawList._VtxCurrentIdx + 3);
+        DrawList._IdxWritePtr += 6;
+        DrawList._VtxCurrentIdx += 4;
+    }
+
+    static inline void PrimLineQuad(ImDrawList &DrawList, float ax, float ay, float bx, float by, float cx, float cy, float dx, float dy, const ImVec2 &uv, ImU32 col)
+    {
+        PrimLineQuad(DrawList, ax, ay, bx, by, cx, cy, dx, dy, uv, uv, col);
+    }
+
+    // How line quads are drawn, as ImPlot's GetLineRenderProps: when the draw
+    // list does anti-aliased lines from the font atlas' baked line texture, the
+    // quad is widened by one pixel on each side and its two long edges map to
+    // the texture's transparent borders, so the fringe comes from the texture
+    // rather than extra geometry. Otherwise it is a solid quad of the line width.
+    struct PrimLineProps
+    {
+        ImVec2 UV0, UV1;
+        float HalfWeight;
+    };
+
+    static inline PrimLineProps GetPrimLineProps(const ImDrawList &DrawList, float weight)
+    {
+        PrimLineProps props;
+        const bool aa = (DrawList.Flags & ImDrawListFlags_AntiAliasedLines) && (DrawList.Flags & ImDrawListFlags_AntiAliasedLinesUseTex);
+        if (aa && weight >= 0 && (int)weight <= IM_DRAWLIST_TEX_LINES_WIDTH_MAX)
         {
-            const ImPlotNextItemData &s = GetItemData();
-            ImDrawList &DrawList = *GetPlotDrawList();
-            if (count > 1 && s.RenderLine)
+            const ImVec4 tex_uvs = DrawList._Data->TexUvLines[(int)weight];
+            props.UV0 = ImVec2(tex_uvs.x, tex_uvs.y);
+            props.UV1 = ImVec2(tex_uvs.z, tex_uvs.w);
+            props.HalfWeight = weight * 0.5f + 1;
+        }
+        else
+        {
+            props.UV0 = props.UV1 = DrawList._Data->TexUvWhitePixel;
+            props.HalfWeight = weight * 0.5f;
+        }
+        return props;
+    }
+
+    // Writes the quad of the line segment P1-P2.
+    static inline void PrimLine(ImDrawList &DrawList, float x1, float y1, float x2, float y2, const PrimLineProps &line, ImU32 col)
+    {
+        float dx = x2 - x1;
+        float dy = y2 - y1;
+        IMPLOT_NORMALIZE2F_OVER_ZERO(dx, dy);
+        dx *= line.HalfWeight;
+        dy *= line.HalfWeight;
+        PrimLineQuad(DrawList, x1 + dy, y1 - dx, x2 + dy, y2 - dx, x2 - dy, y2 + dx, x1 - dy, y1 + dx, line.UV0, line.UV1, col);
+    }
+
+    // false if any coordinate is NaN or infinite, i.e. has all exponent bits
+    // set. Tests the bits rather than comparing, so it holds under /fp:fast.
+    static inline bool SegmentFinite(float x1, float y1, float x2, float y2)
+    {
+        const float v[4] = {x1, y1, x2, y2};
+        unsigned int b[4];
+        memcpy(b, v, sizeof(b));
+        const unsigned int exp = 0x7F800000u;
+        return ImMax(ImMax(b[0] & exp, b[1] & exp), ImMax(b[2] & exp, b[3] & exp)) != exp;
+    }
+
+    // Largest vertex index one draw command can address with ImDrawIdx.
+    static constexpr unsigned int kPrimMaxIdx = sizeof(ImDrawIdx) == 2 ? 0xFFFFu : 0xFFFFFFFFu;
+
+    // Primitives of the next chunk out of left: as many as the current draw
+    // command has room for, or a new command's worth if that is too little.
+    static inline unsigned int PrimChunkSize(const ImDrawList &DrawList, unsigned int left, unsigned int vtx_per_prim)
+    {
+        const unsigned int cnt = ImMin(left, (kPrimMaxIdx - DrawList._VtxCurrentIdx) / vtx_per_prim);
+        // too little room left to be worth it, start a new command instead
+        return cnt < ImMin(64u, left) ? ImMin(left, kPrimMaxIdx / vtx_per_prim) : cnt;
+    }
+
+    // Calls emit(first, cnt) for consecutive chunks of [0, prims), each with room
+    // reserved for cnt primitives of at most idx/vtx_per_prim, and gives back
+    // whatever the chunk did not write. As in ImPlot's RenderPrimitivesEx, with
+    // 16-bit ImDrawIdx a chunk fills the current draw command up to 64K vertices
+    // and the next PrimReserve starts a new one at a new VtxOffset (this needs
+    // ImGuiBackendFlags_RendererHasVtxOffset, like ImPlot itself). With 32-bit
+    // indices an item is a single chunk.
+    template <typename Emit>
+    void PrimChunks(ImDrawList &DrawList, unsigned int prims, unsigned int idx_per_prim, unsigned int vtx_per_prim, Emit emit)
+    {
+        unsigned int first = 0;
+        while (first < prims)
+        {
+            const unsigned int cnt = PrimChunkSize(DrawList, prims - first, vtx_per_prim);
+            DrawList.PrimReserve(cnt * idx_per_prim, cnt * vtx_per_prim);
+            const ImDrawVert *vtx = DrawList._VtxWritePtr;
+            const ImDrawIdx *idx = DrawList._IdxWritePtr;
+            emit(first, cnt);
+            DrawList.PrimUnreserve(cnt * idx_per_prim - (int)(DrawList._IdxWritePtr - idx), cnt * vtx_per_prim - (int)(DrawList._VtxWritePtr - vtx));
+            first += cnt;
+        }
+    }
+
+    // Writes a polyline through pixel space points as one quad per segment,
+    // broken at non-finite points. Segments outside cull_rect are skipped.
+    static inline void PrimPolyline(ImDrawList &DrawList, const ImVec2 *pts, int count, const ImRect &cull_rect, const PrimLineProps &line, ImU32 col)
+    {
+        if (count < 2)
+            return;
+        PrimChunks(DrawList, count - 1, 6, 4, [&](unsigned int first, unsigned int cnt) {
+            for (unsigned int i = first; i < first + cnt; ++i)
             {
-                const ImU32 col = ImGui::GetColorU32(s.Colors[ImPlotCol_Line]);
-                const float weight = s.LineWeight;
-                unsigned int prims = count - 1;
-                unsigned int prims_culled = 0;
-                unsigned int idx = 0;
-                const ImVec2 uv = DrawList._Data->TexUvWhitePixel;
+                const ImVec2 &P1 = pts[i], &P2 = pts[i + 1];
+                if (SegmentFinite(P1.x, P1.y, P2.x, P2.y) && cull_rect.Overlaps(ImRect(ImMin(P1, P2), ImMax(P1, P2))))
+                    PrimLine(DrawList, P1.x, P1.y, P2.x, P2.y, line, col);
+            }
+        });
+    }
+
+    // Plot to pixel transform of the plot's current x/y axes. Coordinates are
+    // made relative to the view minimum in double and only then converted to
+    // float, so large values such as epoch timestamps (~1.6e9, where a float
+    // step is 128) keep sub-pixel accuracy. An axis with a scale (log, symlog,
+    // custom) is linear in its forward transform, so for those Min*Plt and M*
+    // are given in transformed space. X/Y apply the linear part only;
+    // PlotPixelTransformT adds the forward transforms.
+    struct PlotPixelTransform
+    {
+        PlotPixelTransform() {}
+        PlotPixelTransform(const ImPlotPlot &plot)
+        {
+            SetAxis(plot.Axes[plot.CurrentX], &MinXPix, &MinXPlt, &Mx);
+            SetAxis(plot.Axes[plot.CurrentY], &MinYPix, &MinYPlt, &My);
+        }
+        static void SetAxis(const ImPlotAxis &axis, float *min_pix, double *min_plt, float *m)
+        {
+            *min_pix = axis.PixelMin;
+            if (axis.TransformForward == nullptr)
+            {
+                *min_plt = axis.Range.Min;
+                *m = (float)axis.ScaleToPixel;
+            }
+            else
+            {
+                *min_plt = axis.ScaleMin;
+                *m = (float)((axis.PixelMax - axis.PixelMin) / (axis.ScaleMax - axis.ScaleMin));
+            }
+        }
+        float X(double x) const { return MinXPix + Mx * (float)(x - MinXPlt); }
+        float Y(double y) const { return MinYPix + My * (float)(y - MinYPlt); }
+        double MinXPlt, MinYPlt; // origin, subtracted before going to float
+        float MinXPix, MinYPix, Mx, My;
+    };
 
-                const float minx_pix = gp.CurrentPlot->Axes[ImAxis_X1].PixelMin;
-                const float miny_pix = gp.CurrentPlot->Axes[ImAxis_Y1].PixelMin;
-                const float minx_plt = gp.CurrentPlot->Axes[ImAxis_X1].Range.Min;
-                const float miny_plt = gp.CurrentPlot->Axes[ImAxis_Y1].Range.Min;
-                const float mx = gp.CurrentPlot->Axes[ImAxis_X1].ScaleToPixel;
-                const float my = gp.CurrentPlot->Axes[ImAxis_Y1].ScaleToPixel;
+    // Forward transforms of the axis scales, as in implot.cpp. Time axes have no
+    // transform and use PlotScaleLinear.
+    struct PlotScaleLinear
+    {
+        static constexpr bool Linear = true;
+        PlotScaleLinear(const ImPlotAxis &) {}
+        double operator()(double v) const { return v; }
+    };
 
-                ImRect cull_rect = gp.CurrentPlot->PlotRect;
-                ImPlotPoint plt = ImPlotPoint(xs[0], ys[0]);
-                ImVec2 P1 = ImVec2(minx_pix + mx * ((float)plt.x - minx_plt),
-                                   miny_pix + my * ((float)plt.y - miny_plt));
+    struct PlotScaleLog10
+    {
+        static constexpr bool Linear = false;
+        PlotScaleLog10(const ImPlotAxis &) {}
+        double operator()(double v) const { return ImLog10(v <= 0.0 ? DBL_MIN : v); }
+    };
+
+    struct PlotScaleSymLog
+    {
+        static constexpr bool Linear = false;
+        PlotScaleSymLog(const ImPlotAxis &) {}
+        double operator()(double v) const { return 2.0 * ImAsinh(v / 2.0); }
+    };
+
+    // user transform from SetupAxisScale(axis, forward, inverse, data)
+    struct PlotScaleCustom
+    {
+        static constexpr bool Linear = false;
+        PlotScaleCustom(const ImPlotAxis &axis) : Forward(axis.TransformForward), Data(axis.TransformData) {}
+        double operator()(double v) const { return Forward(v, Data); }
+        ImPlotTransform Forward;
+        void *Data;
+    };
+
+    template <typename ScaleX, typename ScaleY>
+    struct PlotPixelTransformT : PlotPixelTransform
+    {
+        static constexpr bool Linear = ScaleX::Linear && ScaleY::Linear;
+        PlotPixelTransformT(const ImPlotPlot &plot)
+            : PlotPixelTransform(plot), FX(plot.Axes[plot.CurrentX]), FY(plot.Axes[plot.CurrentY]) {}
+        float X(double x) const { return PlotPixelTransform::X(FX(x)); }
+        float Y(double y) const { return PlotPixelTransform::Y(FY(y)); }
+        ScaleX FX;
+        ScaleY FY;
+    };
+
+    // Calls fn(scale) with the PlotScale* of an axis.
+    template <typename F>
+    void DispatchAxisScale(const ImPlotAxis &axis, F fn)
+    {
+        switch (axis.TransformForward == nullptr ? ImPlotScale_Linear : axis.Scale)
+        {
+        case ImPlotScale_Linear:
+        case ImPlotScale_Time: fn(PlotScaleLinear(axis)); break;
+        case ImPlotScale_Log10: fn(PlotScaleLog10(axis)); break;
+        case ImPlotScale_SymLog: fn(PlotScaleSymLog(axis)); break;
+        default: fn(PlotScaleCustom(axis)); break;
+        }
+    }
+
+    // Calls fn(xf) with the PlotPixelTransformT of the current axes. Kernels
+    // taking xf as a template are compiled for every scale combination and pick
+    // theirs once per item, with no per point branches or calls for built in
+    // scales.
+    template <typename F>
+    void DispatchPixelTransform(const ImPlotPlot &plot, F fn)
+    {
+        DispatchAxisScale(plot.Axes[plot.CurrentX], [&](auto sx) {
+            DispatchAxisScale(plot.Axes[plot.CurrentY], [&](auto sy) {
+                fn(PlotPixelTransformT<decltype(sx), decltype(sy)>(plot));
+            });
+        });
+    }
+
+    // Point sources of the line kernels: X(i)/Y(i) read point i and Skip(n)
+    // drops the first n points. Simd is true where the AVX2 kernel has loads
+    // for the layout.
+
+    // separate x and y arrays
+    template <typename T>
+    struct LineArrays
+    {
+        static constexpr bool Simd = std::is_same<T, float>::value || std::is_same<T, double>::value;
+        T X(int i) const { return Xs[i]; }
+        T Y(int i) const { return Ys[i]; }
+        LineArrays Skip(int n) const { return {Xs + n, Ys + n}; }
+        const T *Xs, *Ys;
+    };
+
+    // interleaved x, y pairs such as ImVec2 (float) and ImPlotPoint (double)
+    template <typename T>
+    struct LinePoints
+    {
+        static constexpr bool Simd = std::is_same<T, float>::value || std::is_same<T, double>::value;
+        T X(int i) const { return Pts[2 * i]; }
+        T Y(int i) const { return Pts[2 * i + 1]; }
+        LinePoints Skip(int n) const { return {Pts + 2 * n}; }
+        const T *Pts;
+    };
+
+    // any other byte stride, e.g. x and y fields of a larger struct
+    template <typename T>
+    struct LineStrided
+    {
+        static constexpr bool Simd = false;
+        T X(int i) const { return *(const T *)((const unsigned char *)Xs + (size_t)i * Stride); }
+        T Y(int i) const { return *(const T *)((const unsigned char *)Ys + (size_t)i * Stride); }
+        LineStrided Skip(int n) const { return {(const T *)((const unsigned char *)Xs + (size_t)n * Stride), (const T *)((const unsigned char *)Ys + (size_t)n * Stride), Stride}; }
+        const T *Xs, *Ys;
+        int Stride;
+    };
+
+#ifdef IMPLOT_LINE_AVX2
+    static inline bool CpuHasAvx2()
+    {
+#if defined _MSC_VER
+        int regs[4];
+        __cpuid(regs, 1);
+        const bool avx = (regs[2] & (1 << 27)) && (regs[2] & (1 << 28)) && (_xgetbv(0) & 6) == 6; // OSXSAVE, AVX, YMM state
+        if (!avx || (__cpuid(regs, 0), regs[0] < 7))
+            return false;
+        __cpuidex(regs, 7, 0);
+        return (regs[1] & (1 << 5)) != 0;
+#else
+        return __builtin_cpu_supports("avx2");
+#endif
+    }
+
+    // Origin of an axis for LoadLine8. Float data cannot take the double origin
+    // directly, so it is subtracted as a float pair: hi, exact when the values
+    // are near the origin, then the small remainder lo.
+    struct LineOrigin8
+    {
+        IMPLOT_AVX2_TARGET LineOrigin8(double origin)
+            : D(_mm256_set1_pd(origin)), Hi(_mm256_set1_ps((float)origin)), Lo(_mm256_set1_ps((float)(origin - (float)origin))) {}
+        __m256d D;
+        __m256 Hi, Lo;
+    };
+
+    // loads 8 values relative to the origin, as floats
+    IMPLOT_AVX2_TARGET static inline __m256 LoadLine8(const float *v, const LineOrigin8 &o)
+    {
+        return _mm256_sub_ps(_mm256_sub_ps(_mm256_loadu_ps(v), o.Hi), o.Lo);
+    }
+    IMPLOT_AVX2_TARGET static inline __m256 LoadLine8(const double *v, const LineOrigin8 &o)
+    {
+        return _mm256_set_m128(_mm256_cvtpd_ps(_mm256_sub_pd(_mm256_loadu_pd(v + 4), o.D)), _mm256_cvtpd_ps(_mm256_sub_pd(_mm256_loadu_pd(v), o.D)));
+    }
+
+    // points [i, i + 8) of a source as x and y relative to their origins
+    template <typename T>
+    IMPLOT_AVX2_TARGET static inline void LoadLine8(const LineArrays<T> &src, int i, const LineOrigin8 &ox, const LineOrigin8 &oy, __m256 *x, __m256 *y)
+    {
+        *x = LoadLine8(src.Xs + i, ox);
+        *y = LoadLine8(src.Ys + i, oy);
+    }
+
+    // ImVec2: the even and odd floats of two loads are picked by one shuffle per
+    // lane, which leaves points 0 1 4 5 | 2 3 6 7, then put in order by a
+    // 64-bit permute
+    IMPLOT_AVX2_TARGET static inline void LoadLine8(const LinePoints<float> &src, int i, const LineOrigin8 &ox, const LineOrigin8 &oy, __m256 *x, __m256 *y)
+    {
+        const __m256 a = _mm256_loadu_ps(src.Pts + 2 * i);
+        const __m256 b = _mm256_loadu_ps(src.Pts + 2 * i + 8);
+        const __m256 xs = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(_mm256_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0))), _MM_SHUFFLE(3, 1, 2, 0)));
+        const __m256 ys = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(_mm256_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1))), _MM_SHUFFLE(3, 1, 2, 0)));
+        *x = _mm256_sub_ps(_mm256_sub_ps(xs, ox.Hi), ox.Lo);
+        *y = _mm256_sub_ps(_mm256_sub_ps(ys, oy.Hi), oy.Lo);
+    }
+
+    // ImPlotPoint: pairs of loads of two points each are regrouped by 128-bit
+    // lane into x0 y0 x2 y2 and x1 y1 x3 y3, then unpacked into x and y
+    IMPLOT_AVX2_TARGET static inline void LoadLine4(const double *pts, const LineOrigin8 &ox, const LineOrigin8 &oy, __m128 *x, __m128 *y)
+    {
+        const __m256d a = _mm256_loadu_pd(pts);
+        const __m256d b = _mm256_loadu_pd(pts + 4);
+        const __m256d even = _mm256_permute2f128_pd(a, b, 0x20);
+        const __m256d odd = _mm256_permute2f128_pd(a, b, 0x31);
+        *x = _mm256_cvtpd_ps(_mm256_sub_pd(_mm256_unpacklo_pd(even, odd), ox.D));
+        *y = _mm256_cvtpd_ps(_mm256_sub_pd(_mm256_unpackhi_pd(even, odd), oy.D));
+    }
+    IMPLOT_AVX2_TARGET static inline void LoadLine8(const LinePoints<double> &src, int i, const LineOrigin8 &ox, const LineOrigin8 &oy, __m256 *x, __m256 *y)
+    {
+        __m128 x0, y0, x1, y1;
+        LoadLine4(src.Pts + 2 * i, ox, oy, &x0, &y0);
+        LoadLine4(src.Pts + 2 * i + 8, ox, oy, &x1, &y1);
+        *x = _mm256_set_m128(x1, x0);
+        *y = _mm256_set_m128(y1, y0);
+    }
+
+    // Emits segments [0, prims & ~7) eight at a time and returns how many were
+    // processed; the caller finishes the tail. Segments are culled exactly like
+    // the scalar loop, and segments with a non-finite end (NaN gaps) are masked
+    // out with them rather than branched on. When all eight are visible, vertices are written with
+    // 128-bit stores and indices with one vector add per 16 (or 8) indices.
+    template <typename Source>
+    IMPLOT_AVX2_TARGET static int PlotLineInlineAvx2(ImDrawList &DrawList, const Source &src, int prims, const PlotPixelTransform &xf, const ImRect &cull_rect, const PrimLineProps &line, ImU32 col, unsigned int *prims_culled)
+    {
+        alignas(32) static const ImDrawIdx kIdxPattern[48] = {
+            0, 1, 2, 0, 2, 3, 4, 5, 6, 4, 6, 7, 8, 9, 10, 8, 10, 11, 12, 13, 14, 12, 14, 15,
+            16, 17, 18, 16, 18, 19, 20, 21, 22, 20, 22, 23, 24, 25, 26, 24, 26, 27, 28, 29, 30, 28, 30, 31};
+        const __m256 min_x_pix = _mm256_set1_ps(xf.MinXPix), min_y_pix = _mm256_set1_ps(xf.MinYPix);
+        const LineOrigin8 x_origin(xf.MinXPlt), y_origin(xf.MinYPlt);
+        const __m256 mx = _mm256_set1_ps(xf.Mx), my = _mm256_set1_ps(xf.My);
+        const __m256 cull_min_x = _mm256_set1_ps(cull_rect.Min.x), cull_max_x = _mm256_set1_ps(cull_rect.Max.x);
+        const __m256 cull_min_y = _mm256_set1_ps(cull_rect.Min.y), cull_max_y = _mm256_set1_ps(cull_rect.Max.y);
+        const __m256 hw = _mm256_set1_ps(line.HalfWeight);
+        const ImVec2 uv0 = line.UV0, uv1 = line.UV1;
+        const __m256 zero = _mm256_setzero_ps();
+        const __m256i exp_bits = _mm256_set1_epi32(0x7F800000);
+        float colf;
+        memcpy(&colf, &col, sizeof(colf));
+
+        alignas(32) float corners[8][8]; // ax, ay, bx, by, cx, cy, dx, dy of 8 segments
+        const int simd_prims = prims & ~7;
+        for (int i = 0; i < simd_prims; i += 8)
+        {
+            __m256 x1, y1, x2, y2;
+            LoadLine8(src, i, x_origin, y_origin, &x1, &y1);
+            LoadLine8(src, i + 1, x_origin, y_origin, &x2, &y2);
+            x1 = _mm256_add_ps(min_x_pix, _mm256_mul_ps(mx, x1));
+            y1 = _mm256_add_ps(min_y_pix, _mm256_mul_ps(my, y1));
+            x2 = _mm256_add_ps(min_x_pix, _mm256_mul_ps(mx, x2));
+            y2 = _mm256_add_ps(min_y_pix, _mm256_mul_ps(my, y2));
 
-                DrawList.PrimReserve(prims * 6, prims * 4);
-                for (unsigned int idx = 0; idx < prims; ++idx)
+            // min/max pass a NaN first operand through as the other one, so
+            // non-finite lanes (exponent bits all set, as SegmentFinite) are
+            // cleared separately
+            const __m256i exp_max = _mm256_max_epu32(
+                _mm256_max_epu32(_mm256_and_si256(_mm256_castps_si256(x1), exp_bits), _mm256_and_si256(_mm256_castps_si256(y1), exp_bits)),
+                _mm256_max_epu32(_mm256_and_si256(_mm256_castps_si256(x2), exp_bits), _mm256_and_si256(_mm256_castps_si256(y2), exp_bits)));
+            const __m256 non_finite = _mm256_castsi256_ps(_mm256_cmpeq_epi32(exp_max, exp_bits));
+            const __m256 visible = _mm256_andnot_ps(non_finite, _mm256_and_ps(
+                _mm256_and_ps(_mm256_cmp_ps(_mm256_min_ps(x1, x2), cull_max_x, _CMP_LT_OQ), _mm256_cmp_ps(_mm256_max_ps(x1, x2), cull_min_x, _CMP_GT_OQ)),
+                _mm256_and_ps(_mm256_cmp_ps(_mm256_min_ps(y1, y2), cull_max_y, _CMP_LT_OQ), _mm256_cmp_ps(_mm256_max_ps(y1, y2), cull_min_y, _CMP_GT_OQ))));
+            const int mask = _mm256_movemask_ps(visible);
+            if (mask == 0)
+            {
+                *prims_culled += 8;
+                continue;
+            }
+
+            // normal, scaled to half the line weight (zero length segments stay zero)
+            __m256 dx = _mm256_sub_ps(x2, x1);
+            __m256 dy = _mm256_sub_ps(y2, y1);
+            const __m256 d2 = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy));
+            const __m256 inv_len = _mm256_and_ps(_mm256_rsqrt_ps(d2), _mm256_cmp_ps(d2, zero, _CMP_GT_OQ));
+            dx = _mm256_mul_ps(dx, _mm256_mul_ps(inv_len, hw));
+            dy = _mm256_mul_ps(dy, _mm256_mul_ps(inv_len, hw));
+            _mm256_store_ps(corners[0], _mm256_add_ps(x1, dy));
+            _mm256_store_ps(corners[1], _mm256_sub_ps(y1, dx));
+            _mm256_store_ps(corners[2], _mm256_add_ps(x2, dy));
+            _mm256_store_ps(corners[3], _mm256_sub_ps(y2, dx));
+            _mm256_store_ps(corners[4], _mm256_sub_ps(x2, dy));
+            _mm256_store_ps(corners[5], _mm256_add_ps(y2, dx));
+            _mm256_store_ps(corners[6], _mm256_sub_ps(x1, dy));
+            _mm256_store_ps(corners[7], _mm256_add_ps(y1, dx));
+
+            if (mask != 0xFF)
+            {
+                for (int k = 0; k < 8; ++k)
                 {
-                    plt = ImPlotPoint(xs[idx + 1], ys[idx + 1]);
-                    ImVec2 P2 = ImVec2(minx_pix + mx * ((float)plt.x - minx_plt),
-                                       miny_pix + my * ((float)plt.y - miny_plt));
-                    if (!cull_rect.Overlaps(ImRect(ImMin(P1, P2), ImMax(P1, P2)))) {
-                        P1 = P2;
-                        prims_culled++;
-                        continue;
-                    }
-                    float dx = P2.x - P1.x;
-                    float dy = P2.y - P1.y;
-                    IMPLOT_NORMALIZE2F_OVER_ZERO(dx, dy);
-                    dx *= (weight * 0.5f);
-                    dy *= (weight * 0.5f);
-                    DrawList._VtxWritePtr[0].pos.x = P1.x + dy;
-                    DrawList._VtxWritePtr[0].pos.y = P1.y - dx;
-                    DrawList._VtxWritePtr[0].uv = uv;
-                    DrawList._VtxWritePtr[0].col = col;
-                    DrawList._VtxWritePtr[1].pos.x = P2.x + dy;
-                    DrawList._VtxWritePtr[1].pos.y = P2.y - dx;
-                    DrawList._VtxWritePtr[1].uv = uv;
-                    DrawList._VtxWritePtr[1].col = col;
-                    DrawList._VtxWritePtr[2].pos.x = P2.x - dy;
-                    DrawList._VtxWritePtr[2].pos.y = P2.y + dx;
-                    DrawList._VtxWritePtr[2].uv = uv;
-                    DrawList._VtxWritePtr[2].col = col;
-                    DrawList._VtxWritePtr[3].pos.x = P1.x - dy;
-                    DrawList._VtxWritePtr[3].pos.y = P1.y + dx;
-                    DrawList._VtxWritePtr[3].uv = uv;
-                    DrawList._VtxWritePtr[3].col = col;
-                    DrawList._VtxWritePtr += 4;
-                    DrawList._IdxWritePtr[0] = (ImDrawIdx)(DrawList._VtxCurrentIdx);
-                    DrawList._IdxWritePtr[1] = (ImDrawIdx)(DrawList._VtxCurrentIdx + 1);
-                    DrawList._IdxWritePtr[2] = (ImDrawIdx)(DrawList._VtxCurrentIdx + 2);
-                    DrawList._IdxWritePtr[3] = (ImDrawIdx)(DrawList._VtxCurrentIdx);
-                    DrawList._IdxWritePtr[4] = (ImDrawIdx)(DrawList._VtxCurrentIdx + 2);
-                    DrawList._IdxWritePtr[5] = (ImDrawIdx)(DrawList._VtxCurrentIdx + 3);
-                    DrawList._IdxWritePtr += 6;
-                    DrawList._VtxCurrentIdx += 4;
-                    P1 = P2;
+                    if (mask & (1 << k))
+                        PrimLineQuad(DrawList, corners[0][k], corners[1][k], corners[2][k], corners[3][k], corners[4][k], corners[5][k], corners[6][k], corners[7][k], uv0, uv1, col);
+                    else
+                        (*prims_culled)++;
                 }
-                DrawList.PrimUnreserve(prims_culled * 6, prims_culled * 4);
+                continue;
             }
-            EndItem();
+
+            // 8 quads of 4 vertices, 5 floats each: pos.x pos.y uv.x uv.y col
+            float *v = (float *)DrawList._VtxWritePtr;
+            for (int k = 0; k < 8; ++k, v += 20)
+            {
+                _mm_storeu_ps(v + 0, _mm_setr_ps(corners[0][k], corners[1][k], uv0.x, uv0.y));
+                _mm_storeu_ps(v + 4, _mm_setr_ps(colf, corners[2][k], corners[3][k], uv0.x));
+                _mm_storeu_ps(v + 8, _mm_setr_ps(uv0.y, colf, corners[4][k], corners[5][k]));
+                _mm_storeu_ps(v + 12, _mm_setr_ps(uv1.x, uv1.y, colf, corners[6][k]));
+                _mm_storeu_ps(v + 16, _mm_setr_ps(corners[7][k], uv1.x, uv1.y, colf));
+            }
+            DrawList._VtxWritePtr += 32;
+            if (sizeof(ImDrawIdx) == 2)
+            {
+                const __m256i base = _mm256_set1_epi16((short)DrawList._VtxCurrentIdx);
+                for (int k = 0; k < 3; ++k)
+                    _mm256_storeu_si256((__m256i *)DrawList._IdxWritePtr + k, _mm256_add_epi16(base, _mm256_load_si256((const __m256i *)kIdxPattern + k)));
+            }
+            else
+            {
+                const __m256i base = _mm256_set1_epi32((int)DrawList._VtxCurrentIdx);
+                for (int k = 0; k < 6; ++k)
+                    _mm256_storeu_si256((__m256i *)DrawList._IdxWritePtr + k, _mm256_add_epi32(base, _mm256_load_si256((const __m256i *)kIdxPattern + k)));
+            }
+            DrawList._IdxWritePtr += 48;
+            DrawList._VtxCurrentIdx += 32;
         }
+        return simd_prims;
+    }
+#endif
+
+    template <typename Source>
+    static inline int PlotLineInlineSimd(ImDrawList &DrawList, const Source &src, int prims, const PlotPixelTransform &xf, const ImRect &cull_rect, const PrimLineProps &line, ImU32 col, unsigned int *prims_culled)
+    {
+#ifdef IMPLOT_LINE_AVX2
+        if constexpr (Source::Simd)
+        {
+            static const bool avx2 = CpuHasAvx2();
+            if (avx2)
+                return PlotLineInlineAvx2(DrawList, src, prims, xf, cull_rect, line, col, prims_culled);
+        }
+#endif
+        return 0;
+    }
+
+    // true if x is monotonic increasing (and has no NaN), i.e. can be passed
+    // with ImPlotInlineFlags_SortedX; O(n), so check once and keep the result
+    template <typename Source>
+    bool IsSortedXEx(const Source &src, int count)
+    {
+        for (int i = 1; i < count; ++i)
+        {
+            if (!(src.X(i - 1) <= src.X(i)))
+                return false;
+        }
+        return true;
     }
 
     template <typename T>
-    void PlotLineStaged(const char *label_id, const T *xs, const T *ys, int count)
+    bool IsSortedX(const T *xs, int count, int stride = sizeof(T))
+    {
+        return IsSortedXEx(LineStrided<T>{xs, xs, stride}, count);
+    }
+
+    // Index range [*first, *last] of sorted x within [x_min, x_max], with one
+    // point of margin on both sides so segments crossing the edges are kept.
+    // Empty (*last < *first) if all points are on one side.
+    template <typename Source>
+    void FindVisibleRange(const Source &src, int count, double x_min, double x_max, int *first, int *last)
+    {
+        // first index with x >= x_min, then first with x > x_max
+        int lo = 0, hi = count;
+        while (lo < hi)
+        {
+            const int mid = (lo + hi) / 2;
+            if ((double)src.X(mid) < x_min)
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        const int lower = lo;
+        hi = count;
+        while (lo < hi)
+        {
+            const int mid = (lo + hi) / 2;
+            if (!(x_max < (double)src.X(mid)))
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        const int upper = lo;
+        *first = ImMax(0, lower - 1);
+        *last = ImMin(count - 1, upper);
+        if (lower == count || upper == 0)
+            *last = *first - 1;
+    }
+
+    // Emits segments [0, prims) of src at the draw list's write pointers,
+    // which must have room for all of them. Returns the number culled, which
+    // includes segments dropped for a non-finite end. The AVX2 kernel covers
+    // linear axes only.
+    template <typename Source, typename Transform>
+    unsigned int PlotLineInlineEmit(ImDrawList &DrawList, const Source &src, unsigned int prims, const Transform &xf, const ImRect &cull_rect, const PrimLineProps &line, ImU32 col, ImPlotInlineFlags flags)
     {
-        static ImVector<double> xs_plt; xs_plt.resize(count);
-        static ImVector<double> ys_plt; ys_plt.resize(count);
-        static ImVector<float>  xs_pix; xs_pix.resize(count);  
-        static ImVector<float>  ys_pix; ys_pix.resize(count);
+        unsigned int prims_culled = 0;
+        unsigned int start = 0;
+        if constexpr (Transform::Linear)
+            start = !(flags & ImPlotInlineFlags_NoSimd) ? PlotLineInlineSimd(DrawList, src, (int)prims, xf, cull_rect, line, col, &prims_culled) : 0;
+
+        ImVec2 P1 = ImVec2(xf.X((double)src.X(start)), xf.Y((double)src.Y(start)));
+        for (unsigned int idx = start; idx < prims; ++idx)
+        {
+            ImVec2 P2 = ImVec2(xf.X((double)src.X(idx + 1)), xf.Y((double)src.Y(idx + 1)));
+            if (!(SegmentFinite(P1.x, P1.y, P2.x, P2.y) & cull_rect.Overlaps(ImRect(ImMin(P1, P2), ImMax(P1, P2))))) {
+                P1 = P2;
+                prims_culled++;
+                continue;
+            }
+            PrimLine(DrawList, P1.x, P1.y, P2.x, P2.y, line, col);
+            P1 = P2;
+        }
+        return prims_culled;
+    }
+
+    // PlotLineInlineEmit over [0, prims) in chunks as PrimChunks, split across
+    // the thread pool. All chunks (with 16-bit indices, one per draw command)
+    // are reserved up front and the segments divided evenly between tasks
+    // regardless of chunk boundaries. A piece, one task's part of one chunk,
+    // writes into its own slice of that chunk's reservation (4 vertices and 6
+    // indices per segment, indices already offset to the slice). Then the
+    // pieces are moved down over the culled gaps in order, their indices
+    // rebased within their command, and the commands' offsets and element
+    // counts adjusted. The triangles equal the single-threaded path's; with
+    // 16-bit indices commands may split earlier, as a chunk with culled
+    // segments is not topped up from the next.
+    template <typename Source, typename Transform>
+    unsigned int PlotLineInlineEmitThreaded(ImDrawList &DrawList, const Source &src, unsigned int prims, const Transform &xf, const ImRect &cull_rect, const PrimLineProps &line, ImU32 col, ImPlotInlineFlags flags)
+    {
+        static constexpr int kMinPerTask = 1 << 16;
+        unsigned int prims_culled = 0;
+        const int tasks = ParallelTasks((int)prims, kMinPerTask);
+        if (tasks == 1)
+        {
+            PrimChunks(DrawList, prims, 6, 4, [&](unsigned int first, unsigned int cnt) {
+                prims_culled += PlotLineInlineEmit(DrawList, src.Skip(first), cnt, xf, cull_rect, line, col, flags);
+            });
+            return prims_culled;
+        }
 
-        for (int i = 0; i < count; ++i) {
-            xs_plt[i] = (double)xs[i];
-            ys_plt[i] = (double)ys[i];
+        struct Chunk
+        {
+            unsigned int First, Count; // segments
+            unsigned int Vtx, Idx;     // start of the reservation in the buffers
+            unsigned int Base;         // _VtxCurrentIdx at its first vertex
+            int Cmd;
+        };
+        ImVector<Chunk> chunks;
+        for (unsigned int first = 0; first < prims;)
+        {
+            Chunk chunk;
+            chunk.First = first;
+            chunk.Count = PrimChunkSize(DrawList, prims - first, 4);
+            DrawList.PrimReserve(chunk.Count * 6, chunk.Count * 4);
+            chunk.Vtx = DrawList.VtxBuffer.Size - chunk.Count * 4;
+            chunk.Idx = DrawList.IdxBuffer.Size - chunk.Count * 6;
+            chunk.Base = DrawList._VtxCurrentIdx;
+            chunk.Cmd = DrawList.CmdBuffer.Size - 1;
+            // as if written, so the next chunk gets the next command
+            DrawList._VtxCurrentIdx += chunk.Count * 4;
+            chunks.push_back(chunk);
+            first += chunk.Count;
         }
 
+        struct Piece
+        {
+            int Chunk;
+            unsigned int Begin, End, Culled;
+        };
+        ImVector<Piece> pieces;
+        ImVector<int> task_pieces; // pieces [task_pieces[t], task_pieces[t + 1]) of task t
+        task_pieces.resize(tasks + 1);
+        const unsigned int per_task = (prims + tasks - 1) / tasks;
+        for (int t = 0, c = 0; t < tasks; ++t)
+        {
+            task_pieces[t] = pieces.Size;
+            const unsigned int end = ImMin(prims, (t + 1) * per_task);
+            for (unsigned int begin = ImMin(prims, t * per_task); begin < end;)
+            {
+                while (chunks[c].First + chunks[c].Count <= begin)
+                    ++c;
+                const unsigned int piece_end = ImMin(end, chunks[c].First + chunks[c].Count);
+                pieces.push_back({c, begin, piece_end, 0});
+                begin = piece_end;
+            }
+        }
+        task_pieces[tasks] = pieces.Size;
+
+        ImDrawVert *vtx = DrawList.VtxBuffer.Data;
+        ImDrawIdx *idx = DrawList.IdxBuffer.Data;
+        ParallelRun(tasks, [&](int t) {
+            for (int p = task_pieces[t]; p < task_pieces[t + 1]; ++p)
+            {
+                Piece &piece = pieces[p];
+                const Chunk &chunk = chunks[piece.Chunk];
+                const unsigned int offset = piece.Begin - chunk.First;
+                ImDrawList slice(DrawList._Data);
+                slice._VtxWritePtr = vtx + chunk.Vtx + offset * 4;
+                slice._IdxWritePtr = idx + chunk.Idx + offset * 6;
+                slice._VtxCurrentIdx = chunk.Base + offset * 4;
+                piece.Culled = PlotLineInlineEmit(slice, src.Skip(piece.Begin), piece.End - piece.Begin, xf, cull_rect, line, col, flags);
+            }
+        });
+
+        unsigned int vtx_w = chunks[0].Vtx, idx_w = chunks[0].Idx; // write cursors
+        int cmd = -1;
+        unsigned int cmd_shift = 0;  // vertices the current command moved down by
+        unsigned int cmd_culled = 0; // segments culled in the current command
+        for (const Piece &piece : pieces)
+        {
+            const Chunk &chunk = chunks[piece.Chunk];
+            const unsigned int offset = piece.Begin - chunk.First;
+            const unsigned int from_v = chunk.Vtx + offset * 4, from_i = chunk.Idx + offset * 6;
+            if (chunk.Cmd != cmd)
+            {
+                // a command started by this item moves down with its first chunk
+                cmd = chunk.Cmd;
+                ImDrawCmd &draw_cmd = DrawList.CmdBuffer[cmd];
+                cmd_shift = draw_cmd.VtxOffset == chunk.Vtx ? from_v - vtx_w : 0;
+                if (cmd_shift != 0)
+                {
+                    draw_cmd.VtxOffset -= cmd_shift;
+                    draw_cmd.IdxOffset -= from_i - idx_w;
+                }
+                cmd_culled = 0;
+            }
+            const unsigned int emitted = piece.End - piece.Begin - piece.Culled;
+            if (from_v != vtx_w && emitted > 0)
+            {
+                const ImDrawIdx rebase = (ImDrawIdx)(from_v - vtx_w - cmd_shift);
+                memmove(vtx + vtx_w, vtx + from_v, emitted * 4 * sizeof(ImDrawVert));
+                ImDrawIdx *dst = idx + idx_w;
+                const ImDrawIdx *from = idx + from_i;
+                for (unsigned int i = 0; i < emitted * 6; ++i)
+                    dst[i] = from[i] - rebase;
+            }
+            DrawList.CmdBuffer[cmd].ElemCount -= piece.Culled * 6;
+            vtx_w += emitted * 4;
+            idx_w += emitted * 6;
+            cmd_culled += piece.Culled;
+            prims_culled += piece.Culled;
+        }
+        DrawList.VtxBuffer.shrink(vtx_w);
+        DrawList.IdxBuffer.shrink(idx_w);
+        DrawList._VtxWritePtr = DrawList.VtxBuffer.Data + vtx_w;
+        DrawList._IdxWritePtr = DrawList.IdxBuffer.Data + idx_w;
+        DrawList._VtxCurrentIdx -= cmd_culled * 4;
+        DrawList._CmdHeader.VtxOffset -= cmd_shift;
+        return prims_culled;
+    }
+
+    template <typename Source>
+    void PlotLineInlineEx(const char *label_id, Source src, int count, ImPlotInlineFlags flags)
+    {
         ImPlotContext &gp = *GImPlot;
         if (BeginItem(label_id, ImPlotCol_Line))
         {
             const ImPlotNextItemData &s = GetItemData();
             ImDrawList &DrawList = *GetPlotDrawList();
+            if (flags & ImPlotInlineFlags_SortedX)
+            {
+                // O(log n) cull of everything left and right of the plot
+                const ImPlotRange &range = gp.CurrentPlot->Axes[gp.CurrentPlot->CurrentX].Range;
+                int first, last;
+                FindVisibleRange(src, count, range.Min, range.Max, &first, &last);
+                src = src.Skip(first);
+                count = last - first + 1;
+            }
             if (count > 1 && s.RenderLine)
             {
                 const ImU32 col = ImGui::GetColorU32(s.Colors[ImPlotCol_Line]);
-                const float weight = s.LineWeight;
-                const unsigned int prims = count - 1;
-                const ImVec2 uv = DrawList._Data->TexUvWhitePixel;
-                const float minx_pix = gp.CurrentPlot->Axes[ImAxis_X1].PixelMin;
-                const float miny_pix = gp.CurrentPlot->Axes[ImAxis_Y1].PixelMin;
-                const float minx_plt = gp.CurrentPlot->Axes[ImAxis_X1].Range.Min;
-                const float miny_plt = gp.CurrentPlot->Axes[ImAxis_Y1].Range.Min;
-                const float mx       = gp.CurrentPlot->Axes[ImAxis_X1].ScaleToPixel;
-                const float my       = gp.CurrentPlot->Axes[ImAxis_Y1].ScaleToPixel;
-                // xform data
-                for (int i = 0; i < count; ++i) {
-                    xs_pix[i] = minx_pix + mx * ((float)xs_plt[i] - minx_plt);
-                    ys_pix[i] = miny_pix + my * ((float)ys_plt[i] - miny_plt);    
-                }        
-                DrawList.PrimReserve(prims * 6, prims * 4);
-                for (unsigned int i = 0; i < prims; ++i)
-                {
-                    const float x1 = xs_pix[i];
-                    const float x2 = xs_pix[i+1];
-                    const float y1 = ys_pix[i];
-                    const float y2 = ys_pix[i+1];
-                    float dx = x2 - x1;
-                    float dy = y2 - y1;
-                    IMPLOT_NORMALIZE2F_OVER_ZERO(dx, dy);
-                    dx *= (weight * 0.5f);
-                    dy *= (weight * 0.5f);
-                    DrawList._VtxWritePtr[0].pos.x = x1 + dy;
-                    DrawList._VtxWritePtr[0].pos.y = y1 - dx;
-                    DrawList._VtxWritePtr[0].uv = uv;
-                    DrawList._VtxWritePtr[0].col = col;
-                    DrawList._VtxWritePtr[1].pos.x = x2 + dy;
-                    DrawList._VtxWritePtr[1].pos.y = y2 - dx;
-                    DrawList._VtxWritePtr[1].uv = uv;
-                    DrawList._VtxWritePtr[1].col = col;
-                    DrawList._VtxWritePtr[2].pos.x = x2 - dy;
-                    DrawList._VtxWritePtr[2].pos.y = y2 + dx;
-                    DrawList._VtxWritePtr[2].uv = uv;
-                    DrawList._VtxWritePtr[2].col = col;
-                    DrawList._VtxWritePtr[3].pos.x = x1 - dy;
-                    DrawList._VtxWritePtr[3].pos.y = y1 + dx;
-                    DrawList._VtxWritePtr[3].uv = uv;
-                    DrawList._VtxWritePtr[3].col = col;
-                    DrawList._VtxWritePtr += 4;
-                    DrawList._IdxWritePtr[0] = (ImDrawIdx)(DrawList._VtxCurrentIdx);
-                    DrawList._IdxWritePtr[1] = (ImDrawIdx)(DrawList._VtxCurrentIdx + 1);
-                    DrawList._IdxWritePtr[2] = (ImDrawIdx)(DrawList._VtxCurrentIdx + 2);
-                    DrawList._IdxWritePtr[3] = (ImDrawIdx)(DrawList._VtxCurrentIdx);
-                    DrawList._IdxWritePtr[4] = (ImDrawIdx)(DrawList._VtxCurrentIdx + 2);
-                    DrawList._IdxWritePtr[5] = (ImDrawIdx)(DrawList._VtxCurrentIdx + 3);
-                    DrawList._IdxWritePtr += 6;
-                    DrawList._VtxCurrentIdx += 4;
-                }
+                unsigned int prims = count - 1;
+                const PrimLineProps line = GetPrimLineProps(DrawList, s.LineWeight);
+                ImRect cull_rect = gp.CurrentPlot->PlotRect;
+                DispatchPixelTransform(*gp.CurrentPlot, [&](const auto &xf) {
+                    if (flags & ImPlotInlineFlags_Threaded)
+                        PlotLineInlineEmitThreaded(DrawList, src, prims, xf, cull_rect, line, col, flags);
+                    else
+                        PrimChunks(DrawList, prims, 6, 4, [&](unsigned int first, unsigned int cnt) {
+                            PlotLineInlineEmit(DrawList, src.Skip(first), cnt, xf, cull_rect, line, col, flags);
+                        });
+                });
             }
             EndItem();
         }
     }
+
+    // Line through xs/ys with the fast emitter. As in PlotLine, stride is the
+    // byte distance between consecutive values; interleaved x, y pairs such as
+    // ImVec2 or ImPlotPoint (stride 2 * sizeof(T), ys == xs + 1) use the
+    // deinterleaving SIMD loads, other strides the scalar loop.
+    template <typename T>
+    void PlotLineInline(const char *label_id, const T *xs, const T *ys, int count, ImPlotInlineFlags flags = 0, int stride = sizeof(T))
+    {
+        if (stride == (int)sizeof(T))
+            PlotLineInlineEx(label_id, LineArrays<T>{xs, ys}, count, flags);
+        else if (stride == 2 * (int)sizeof(T) && ys == xs + 1)
+            PlotLineInlineEx(label_id, LinePoints<T>{xs}, count, flags);
+        else
+            PlotLineInlineEx(label_id, LineStrided<T>{xs, ys, stride}, count, flags);
+    }
+
+    inline void PlotLineInline(const char *label_id, const ImVec2 *pts, int count, ImPlotInlineFlags flags = 0)
+    {
+        PlotLineInlineEx(label_id, LinePoints<float>{&pts[0].x}, count, flags);
+    }
+
+    inline void PlotLineInline(const char *label_id, const ImPlotPoint *pts, int count, ImPlotInlineFlags flags = 0)
+    {
+        PlotLineInlineEx(label_id, LinePoints<double>{&pts[0].x}, count, flags);
+    }
 }
 
 /*
@@ -0,0 +1,323 @@
+#pragma once
+
+#include "plot_line_inline.h"
+#include "plot_threads.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+// Min/max pyramid of a static series at power-of-two block sizes: level l holds
+// the min and max of every block of 2^(l+1) samples, built from the level below.
+// Drawing then reads at most a few summary entries per pixel column at any zoom.
+// NaN samples are gaps: they are skipped, and a block of NaN only is NaN.
+// Pyramids are cached by data pointer and size and rebuilt when the version
+// changes, so bump the version after modifying the data in place, and call
+// ForgetPlotPyramid before freeing a buffer whose address may be reused. Total
+// memory is about twice the series itself (min and max, halving every level);
+// past PlotPyramidMemoryLimit the least recently used pyramids are dropped.
+// The cache may be used from several threads; pyramids are handed out by
+// shared_ptr, so one dropped while another thread draws it stays alive.
+
+namespace ImPlot
+{
+    // NaN by its bits (exponent all set, mantissa non-zero), which /fp:fast keeps
+    template <typename T>
+    static inline bool PyramidNaN(T v)
+    {
+        if constexpr (std::is_same<T, float>::value)
+        {
+            unsigned int b;
+            memcpy(&b, &v, sizeof(b));
+            return (b & 0x7FFFFFFFu) > 0x7F800000u;
+        }
+        else if constexpr (std::is_same<T, double>::value)
+        {
+            unsigned long long b;
+            memcpy(&b, &v, sizeof(b));
+            return (b & 0x7FFFFFFFFFFFFFFFull) > 0x7FF0000000000000ull;
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    // ImMin/ImMax that skip a NaN operand, NaN only if both are
+    template <typename T>
+    static inline T PyramidMin(T a, T b) { return PyramidNaN(a) ? b : PyramidNaN(b) ? a : ImMin(a, b); }
+    template <typename T>
+    static inline T PyramidMax(T a, T b) { return PyramidNaN(a) ? b : PyramidNaN(b) ? a : ImMax(a, b); }
+
+    template <typename T>
+    struct PlotPyramid
+    {
+        struct Level
+        {
+            std::vector<T> Min, Max;
+        };
+
+        void Build(const T *values, int count, int version)
+        {
+            Count = count;
+            Version = version;
+            Levels.clear();
+            int src_size = count;
+            const T *src_min = values, *src_max = values;
+            while (src_size > 1)
+            {
+                // a trailing odd entry becomes a block of its own
+                const int size = (src_size + 1) / 2;
+                Levels.emplace_back();
+                Level &level = Levels.back();
+                level.Min.resize(size);
+                level.Max.resize(size);
+                ParallelRanges(size, [&](int begin, int end) {
+                    for (int i = begin; i < end; ++i)
+                    {
+                        const int j = ImMin(2 * i + 1, src_size - 1);
+                        level.Min[i] = PyramidMin(src_min[2 * i], src_min[j]);
+                        level.Max[i] = PyramidMax(src_max[2 * i], src_max[j]);
+                    }
+                });
+                src_min = level.Min.data();
+                src_max = level.Max.data();
+                src_size = size;
+            }
+        }
+
+        // min and max of samples [first, last] read from blocks of 2^(level+1);
+        // blocks at both ends may reach past the range by less than one block.
+        // NaN if every sample read is NaN.
+        void MinMax(const T *values, int first, int last, int level, T *mn, T *mx) const
+        {
+            if (level < 0)
+            {
+                *mn = *mx = values[first];
+                for (int i = first + 1; i <= last; ++i)
+                {
+                    *mn = PyramidMin(*mn, values[i]);
+                    *mx = PyramidMax(*mx, values[i]);
+                }
+                return;
+            }
+            const Level &lvl = Levels[level];
+            const int shift = level + 1;
+            const int b0 = first >> shift;
+            const int b1 = last >> shift;
+            *mn = lvl.Min[b0];
+            *mx = lvl.Max[b0];
+            for (int b = b0 + 1; b <= b1; ++b)
+            {
+                *mn = PyramidMin(*mn, lvl.Min[b]);
+                *mx = PyramidMax(*mx, lvl.Max[b]);
+            }
+        }
+
+        size_t MemoryBytes() const
+        {
+            size_t bytes = 0;
+            for (auto &level : Levels)
+                bytes += (level.Min.capacity() + level.Max.capacity()) * sizeof(T);
+            return bytes;
+        }
+
+        int Count = 0;
+        int Version = 0;
+        std::vector<Level> Levels;
+    };
+
+    // guards the caches of all types, PlotPyramidTick and changes to PlotPyramidMemory
+    inline std::mutex &PlotPyramidMutex()
+    {
+        static std::mutex mutex;
+        return mutex;
+    }
+
+    // total memory of all cached pyramids, bytes
+    inline std::atomic<size_t> &PlotPyramidMemory()
+    {
+        static std::atomic<size_t> bytes(0);
+        return bytes;
+    }
+
+    // cache size past which least recently used pyramids are dropped, bytes;
+    // set it before plotting from other threads
+    inline size_t &PlotPyramidMemoryLimit()
+    {
+        static size_t bytes = (size_t)512 << 20;
+        return bytes;
+    }
+
+    // call with PlotPyramidMutex() held
+    inline unsigned long long PlotPyramidTick()
+    {
+        static unsigned long long tick = 0;
+        return ++tick;
+    }
+
+    template <typename T>
+    struct PlotPyramidEntry
+    {
+        std::shared_ptr<const PlotPyramid<T>> Pyramid;
+        unsigned long long LastUse = 0; // PlotPyramidTick() at the last GetPlotPyramid
+    };
+
+    template <typename T>
+    struct PlotPyramidKey
+    {
+        const T *Values;
+        int Count;
+        bool operator==(const PlotPyramidKey &other) const { return Values == other.Values && Count == other.Count; }
+    };
+
+    template <typename T>
+    struct PlotPyramidKeyHash
+    {
+        size_t operator()(const PlotPyramidKey<T> &key) const { return std::hash<const T *>()(key.Values) ^ ((size_t)key.Count * 0x9E3779B97F4A7C15ull); }
+    };
+
+    // access with PlotPyramidMutex() held
+    template <typename T>
+    std::unordered_map<PlotPyramidKey<T>, PlotPyramidEntry<T>, PlotPyramidKeyHash<T>> &GetPlotPyramidCache()
+    {
+        static std::unordered_map<PlotPyramidKey<T>, PlotPyramidEntry<T>, PlotPyramidKeyHash<T>> cache;
+        return cache;
+    }
+
+    // Drops the cached pyramid of values, if any. Call before freeing or
+    // refilling a buffer that is not versioned.
+    template <typename T>
+    void ForgetPlotPyramid(const T *values, int count)
+    {
+        std::lock_guard<std::mutex> lock(PlotPyramidMutex());
+        auto &cache = GetPlotPyramidCache<T>();
+        auto it = cache.find({values, count});
+        if (it == cache.end())
+            return;
+        PlotPyramidMemory() -= it->second.Pyramid->MemoryBytes();
+        cache.erase(it);
+    }
+
+    // Drops all cached pyramids of T.
+    template <typename T>
+    void ClearPlotPyramids()
+    {
+        std::lock_guard<std::mutex> lock(PlotPyramidMutex());
+        auto &cache = GetPlotPyramidCache<T>();
+        for (auto &entry : cache)
+            PlotPyramidMemory() -= entry.second.Pyramid->MemoryBytes();
+        cache.clear();
+    }
+
+    // The cached pyramid of values, built if missing or of another version.
+    // Building happens outside the lock: it runs on the thread pool, whose
+    // workers may be waiting for the lock themselves. Two threads missing the
+    // same pyramid at once both build it and the later one is kept.
+    template <typename T>
+    std::shared_ptr<const PlotPyramid<T>> GetPlotPyramid(const T *values, int count, int version = 0)
+    {
+        auto &cache = GetPlotPyramidCache<T>();
+        {
+            std::lock_guard<std::mutex> lock(PlotPyramidMutex());
+            auto it = cache.find({values, count});
+            if (it != cache.end() && it->second.Pyramid->Version == version)
+            {
+                it->second.LastUse = PlotPyramidTick();
+                return it->second.Pyramid;
+            }
+        }
+        auto pyramid = std::make_shared<PlotPyramid<T>>();
+        pyramid->Build(values, count, version);
+
+        std::lock_guard<std::mutex> lock(PlotPyramidMutex());
+        PlotPyramidEntry<T> &entry = cache[{values, count}];
+        if (entry.Pyramid)
+            PlotPyramidMemory() -= entry.Pyramid->MemoryBytes();
+        entry.Pyramid = pyramid;
+        entry.LastUse = PlotPyramidTick();
+        PlotPyramidMemory() += pyramid->MemoryBytes();
+        // evict others of this type, oldest first; the new one always stays
+        while (PlotPyramidMemory() > PlotPyramidMemoryLimit() && cache.size() > 1)
+        {
+            auto oldest = cache.end();
+            for (auto it = cache.begin(); it != cache.end(); ++it)
+                if (&it->second != &entry && (oldest == cache.end() || it->second.LastUse < oldest->second.LastUse))
+                    oldest = it;
+            PlotPyramidMemory() -= oldest->second.Pyramid->MemoryBytes();
+            cache.erase(oldest);
+        }
+        return pyramid;
+    }
+
+    // Line of values at x = x0 + i * xscale, as PlotLine(values, count, xscale, x0).
+    // Visible samples are drawn as is while there are fewer than 4 per pixel
+    // column; above that, every column is drawn as its min/max from the deepest
+    // level with at least two blocks per column. Columns split the visible
+    // samples evenly, which on a log x axis makes them uneven in pixels.
+    template <typename T>
+    void PlotLinePyramid(const char *label_id, const T *values, int count, double xscale = 1, double x0 = 0, int version = 0)
+    {
+        thread_local ImVector<ImVec2> pts; // per thread, as GetPlotStage
+        if (count < 1)
+            return;
+        const std::shared_ptr<const PlotPyramid<T>> pyramid = GetPlotPyramid(values, count, version);
+
+        ImPlotContext &gp = *GImPlot;
+        if (BeginItem(label_id, ImPlotCol_Line))
+        {
+            if (FitThisFrame())
+            {
+                T mn, mx;
+                pyramid->MinMax(values, 0, count - 1, (int)pyramid->Levels.size() - 1, &mn, &mx);
+                FitPoint(ImPlotPoint(x0, (double)mn));
+                FitPoint(ImPlotPoint(x0 + (count - 1) * xscale, (double)mx));
+            }
+            const ImPlotNextItemData &s = GetItemData();
+            ImDrawList &DrawList = *GetPlotDrawList();
+            if (count > 1 && s.RenderLine)
+            {
+                const ImU32 col = ImGui::GetColorU32(s.Colors[ImPlotCol_Line]);
+                const PrimLineProps line = GetPrimLineProps(DrawList, s.LineWeight);
+                const ImPlotAxis &x_axis = gp.CurrentPlot->Axes[gp.CurrentPlot->CurrentX];
+
+                // visible samples, plus one on each side so the line reaches the edges
+                const int i0 = (int)ImClamp(floor((x_axis.Range.Min - x0) / xscale) - 1, 0.0, count - 1.0);
+                const int i1 = (int)ImClamp(ceil((x_axis.Range.Max - x0) / xscale) + 1, 0.0, count - 1.0);
+                const int columns = ImMax(1, (int)gp.CurrentPlot->PlotRect.GetWidth());
+                const double per_col = (double)(i1 - i0 + 1) / columns;
+                int level = -1;
+                while (level + 1 < (int)pyramid->Levels.size() && (2 << (level + 1)) * 2 <= per_col)
+                    ++level;
+
+                pts.resize(0);
+                DispatchPixelTransform(*gp.CurrentPlot, [&](const auto &xf) {
+                    if (per_col < 4)
+                    {
+                        for (int i = i0; i <= i1; ++i)
+                            pts.push_back(ImVec2(xf.X(x0 + i * xscale), xf.Y((double)values[i])));
+                        return;
+                    }
+                    for (int c = 0; c < columns; ++c)
+                    {
+                        const int first = i0 + (int)(c * per_col);
+                        const int last = ImMin(i1, i0 + (int)((c + 1) * per_col) - 1);
+                        if (last < first)
+                            continue;
+                        T vmin, vmax;
+                        pyramid->MinMax(values, first, last, level, &vmin, &vmax);
+                        const float px = xf.X(x0 + first * xscale);
+                        pts.push_back(ImVec2(px, xf.Y((double)vmin)));
+                        pts.push_back(ImVec2(px, xf.Y((double)vmax)));
+                    }
+                });
+                PrimPolyline(DrawList, pts.Data, pts.Size, gp.CurrentPlot->PlotRect, line, col);
+            }
+            EndItem();
+        }
+    }
+}
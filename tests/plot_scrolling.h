@@ -0,0 +1,181 @@
+#pragma once
+
+#include "plot_staging.h"
+
+// Ring buffer series for streaming plots, as the ScrollingBuffer of the ImPlot
+// demo, that keeps its samples' pixel coordinates between frames. Each frame
+// only the samples appended since the last one are transformed. When the view
+// only moved (the usual scroll to follow the newest sample, or the plot itself
+// moving) the cached coordinates are reused with a translation applied while
+// emitting. A change of scale (zoom, resize, axis scale) or a translation too
+// large for float precision transforms the whole buffer again. The cache holds
+// one transform, so a buffer drawn in several plots per frame keeps
+// recomputing; give each plot its own.
+
+namespace ImPlot
+{
+    template <typename T>
+    struct PlotScrollingBuffer
+    {
+        explicit PlotScrollingBuffer(int capacity = 2000) : Capacity(ImMax(2, capacity))
+        {
+            Xs.reserve(Capacity);
+            Ys.reserve(Capacity);
+        }
+
+        // appends a sample, overwriting the oldest once the buffer is full
+        void AddPoint(T x, T y)
+        {
+            if (Xs.Size < Capacity)
+            {
+                Xs.push_back(x);
+                Ys.push_back(y);
+            }
+            else
+            {
+                Xs[Offset] = x;
+                Ys[Offset] = y;
+                Offset = (Offset + 1) % Capacity;
+            }
+            ++Added;
+        }
+
+        void Erase()
+        {
+            Xs.resize(0);
+            Ys.resize(0);
+            Offset = 0;
+            Added = 0;
+            CacheAdded = -1;
+        }
+
+        int Size() const { return Xs.Size; }
+
+        // samples in the order added; the oldest is at Offset once the buffer is
+        // full, so sample k overall lives at k % Capacity
+        int Capacity;
+        int Offset = 0;
+        ImVector<T> Xs, Ys;
+
+        // pixel coordinates of Xs/Ys under CacheXf, same layout
+        ImVector<float> PixXs, PixYs;
+        PlotPixelTransform CacheXf;
+        ImPlotTransform CacheForward[2] = {};
+        void *CacheData[2] = {};
+        long long Added = 0;       // samples added since the last Erase
+        long long CacheAdded = -1; // Added when the cache was last updated, -1 if invalid
+    };
+
+    // Largest translation in pixels applied to cached coordinates before they
+    // are rebased; keeps float steps around 0.004 px or finer.
+    static constexpr float kScrollingMaxShift = 65536.0f;
+
+    // Relative difference in pixels per unit still treated as the same scale.
+    // Scrolling limits such as (t - history, t) give a range that varies in the
+    // last bits; the error this admits stays below 0.02 px within the shift limit.
+    static constexpr float kScrollingScaleTolerance = 2.5e-7f;
+
+    static inline bool ScrollingSameScale(float a, float b)
+    {
+        return ImFabs(a - b) <= kScrollingScaleTolerance * ImMax(ImFabs(a), ImFabs(b));
+    }
+
+    // Brings the buffer's pixel cache up to date for xf and returns the
+    // translation (*dx, *dy) from cached to current pixel coordinates.
+    template <typename T, typename Transform>
+    void UpdateScrollingCache(PlotScrollingBuffer<T> &buf, const ImPlotPlot &plot, const Transform &xf, float *dx, float *dy)
+    {
+        const ImPlotAxis &x_axis = plot.Axes[plot.CurrentX];
+        const ImPlotAxis &y_axis = plot.Axes[plot.CurrentY];
+        const PlotPixelTransform &c = buf.CacheXf;
+        bool full = buf.CacheAdded < 0 || buf.Added - buf.CacheAdded >= buf.Size() ||
+                    buf.CacheForward[0] != x_axis.TransformForward || buf.CacheData[0] != x_axis.TransformData ||
+                    buf.CacheForward[1] != y_axis.TransformForward || buf.CacheData[1] != y_axis.TransformData ||
+                    !ScrollingSameScale(xf.Mx, c.Mx) || !ScrollingSameScale(xf.My, c.My);
+        double shift_x = 0, shift_y = 0;
+        if (!full)
+        {
+            // pix = MinPix + M * (f(v) - MinPlt) moves by a constant when only
+            // MinPix and MinPlt change, but for a non-linear scale MinPlt is in
+            // transformed space, where the same holds
+            shift_x = (double)xf.MinXPix - c.MinXPix - (double)c.Mx * (xf.MinXPlt - c.MinXPlt);
+            shift_y = (double)xf.MinYPix - c.MinYPix - (double)c.My * (xf.MinYPlt - c.MinYPlt);
+            full = fabs(shift_x) > kScrollingMaxShift || fabs(shift_y) > kScrollingMaxShift;
+        }
+
+        const int size = buf.Size();
+        buf.PixXs.resize(size);
+        buf.PixYs.resize(size);
+        if (full)
+        {
+            buf.CacheXf = xf;
+            buf.CacheForward[0] = x_axis.TransformForward;
+            buf.CacheData[0] = x_axis.TransformData;
+            buf.CacheForward[1] = y_axis.TransformForward;
+            buf.CacheData[1] = y_axis.TransformData;
+            TransformAxis(xf.FX, buf.Xs.Data, size, xf.MinXPix, xf.MinXPlt, xf.Mx, buf.PixXs.Data);
+            TransformAxis(xf.FY, buf.Ys.Data, size, xf.MinYPix, xf.MinYPlt, xf.My, buf.PixYs.Data);
+            shift_x = shift_y = 0;
+        }
+        else
+        {
+            // new samples, in the cache's transform, as one or two slices
+            int first = (int)(buf.CacheAdded % buf.Capacity);
+            int left = (int)(buf.Added - buf.CacheAdded);
+            while (left > 0)
+            {
+                const int cnt = ImMin(left, size - first);
+                TransformAxis(xf.FX, buf.Xs.Data + first, cnt, c.MinXPix, c.MinXPlt, c.Mx, buf.PixXs.Data + first);
+                TransformAxis(xf.FY, buf.Ys.Data + first, cnt, c.MinYPix, c.MinYPlt, c.My, buf.PixYs.Data + first);
+                first = 0;
+                left -= cnt;
+            }
+        }
+        buf.CacheAdded = buf.Added;
+        *dx = (float)shift_x;
+        *dy = (float)shift_y;
+    }
+
+    // Line through the buffer's samples from oldest to newest.
+    template <typename T>
+    void PlotLineScrolling(const char *label_id, PlotScrollingBuffer<T> &buf)
+    {
+        ImPlotContext &gp = *GImPlot;
+        if (BeginItem(label_id, ImPlotCol_Line))
+        {
+            const int count = buf.Size();
+            if (FitThisFrame())
+            {
+                for (int i = 0; i < count; ++i)
+                    FitPoint(ImPlotPoint((double)buf.Xs[i], (double)buf.Ys[i]));
+            }
+            const ImPlotNextItemData &s = GetItemData();
+            ImDrawList &DrawList = *GetPlotDrawList();
+            if (count > 1 && s.RenderLine)
+            {
+                const ImU32 col = ImGui::GetColorU32(s.Colors[ImPlotCol_Line]);
+                const PrimLineProps line = GetPrimLineProps(DrawList, s.LineWeight);
+                float dx, dy;
+                DispatchPixelTransform(*gp.CurrentPlot, [&](const auto &xf) { UpdateScrollingCache(buf, *gp.CurrentPlot, xf, &dx, &dy); });
+                // cull in cached coordinates, emit in current ones
+                const ImRect &plot_rect = gp.CurrentPlot->PlotRect;
+                const ImRect cull_rect(plot_rect.Min.x - dx, plot_rect.Min.y - dy, plot_rect.Max.x - dx, plot_rect.Max.y - dy);
+                const float *px = buf.PixXs.Data;
+                const float *py = buf.PixYs.Data;
+                PrimChunks(DrawList, count - 1, 6, 4, [&](unsigned int first, unsigned int cnt) {
+                    int j1 = buf.Offset + (int)first;
+                    if (j1 >= count)
+                        j1 -= count;
+                    for (unsigned int i = 0; i < cnt; ++i)
+                    {
+                        const int j2 = j1 + 1 < count ? j1 + 1 : 0;
+                        if (SegmentVisible(cull_rect, px[j1], py[j1], px[j2], py[j2]))
+                            PrimLine(DrawList, px[j1] + dx, py[j1] + dy, px[j2] + dx, py[j2] + dy, line, col);
+                        j1 = j2;
+                    }
+                });
+            }
+            EndItem();
+        }
+    }
+}
@@ -0,0 +1,162 @@
+#pragma once
+
+#include <implot_internal.h>
+
+// Item styling passed inline as key/value pairs instead of a sequence of
+// SetNextLineStyle/SetNextFillStyle/SetNextMarkerStyle calls:
+//
+//   ImPlot::PlotLine("Line", xs, ys, n, ImPlotSpec_LineColor, col, ImPlotSpec_LineWeight, 2.0f);
+//
+// The spec is built by constexpr functions, so with constant keys the builder
+// folds away and only the fields that were given are written to NextItemData,
+// with no calls into implot.cpp. A spec can also be built once up front:
+//
+//   constexpr ImPlotSpecData spec = ImPlot::MakeSpec(ImPlotSpec_Marker, ImPlotMarker_Circle);
+
+typedef int ImPlotSpec;
+enum ImPlotSpec_
+{
+    ImPlotSpec_LineWeight = 0,  // float
+    ImPlotSpec_LineColor,       // ImVec4
+    ImPlotSpec_FaceColor,       // ImVec4, fill color
+    ImPlotSpec_Marker,          // ImPlotMarker
+    ImPlotSpec_MarkerSize,      // float
+    ImPlotSpec_MarkerFaceColor, // ImVec4
+    ImPlotSpec_MarkerEdgeColor, // ImVec4
+    ImPlotSpec_Stride,          // int, bytes between points, 0 for contiguous
+    ImPlotSpec_Offset,          // int, index of the first point
+    ImPlotSpec_COUNT
+};
+
+struct ImPlotSpecData
+{
+    float LineWeight = IMPLOT_AUTO;
+    ImVec4 LineColor = IMPLOT_AUTO_COL;
+    ImVec4 FaceColor = IMPLOT_AUTO_COL;
+    ImPlotMarker Marker = IMPLOT_AUTO;
+    float MarkerSize = IMPLOT_AUTO;
+    ImVec4 MarkerFaceColor = IMPLOT_AUTO_COL;
+    ImVec4 MarkerEdgeColor = IMPLOT_AUTO_COL;
+    int Stride = 0;
+    int Offset = 0;
+    int Specified = 0; // bit per ImPlotSpec_ that was set
+
+    constexpr bool Has(ImPlotSpec_ spec) const { return (Specified & (1 << spec)) != 0; }
+};
+
+namespace ImPlot
+{
+    // Keys are typed ImPlotSpec_ (not ImPlotSpec) so that the spec overloads of
+    // the Plot functions are never confused with their flags/offset/stride form.
+
+    constexpr void BuildSpec(ImPlotSpecData &S, ImPlotSpec_ spec, float v)
+    {
+        switch (spec)
+        {
+        case ImPlotSpec_LineWeight: S.LineWeight = v; break;
+        case ImPlotSpec_MarkerSize: S.MarkerSize = v; break;
+        default: IM_ASSERT(false && "ImPlotSpec does not take a float"); return;
+        }
+        S.Specified |= 1 << spec;
+    }
+
+    constexpr void BuildSpec(ImPlotSpecData &S, ImPlotSpec_ spec, double v)
+    {
+        BuildSpec(S, spec, (float)v);
+    }
+
+    constexpr void BuildSpec(ImPlotSpecData &S, ImPlotSpec_ spec, int v)
+    {
+        switch (spec)
+        {
+        case ImPlotSpec_LineWeight: S.LineWeight = (float)v; break;
+        case ImPlotSpec_MarkerSize: S.MarkerSize = (float)v; break;
+        case ImPlotSpec_Marker: S.Marker = v; break;
+        case ImPlotSpec_Stride: S.Stride = v; break;
+        case ImPlotSpec_Offset: S.Offset = v; break;
+        default: IM_ASSERT(false && "ImPlotSpec does not take an int"); return;
+        }
+        S.Specified |= 1 << spec;
+    }
+
+    constexpr void BuildSpec(ImPlotSpecData &S, ImPlotSpec_ spec, ImPlotMarker_ v)
+    {
+        IM_ASSERT(spec == ImPlotSpec_Marker && "ImPlotSpec does not take a marker");
+        S.Marker = v;
+        S.Specified |= 1 << spec;
+    }
+
+    constexpr void BuildSpec(ImPlotSpecData &S, ImPlotSpec_ spec, const ImVec4 &v)
+    {
+        switch (spec)
+        {
+        case ImPlotSpec_LineColor: S.LineColor = v; break;
+        case ImPlotSpec_FaceColor: S.FaceColor = v; break;
+        case ImPlotSpec_MarkerFaceColor: S.MarkerFaceColor = v; break;
+        case ImPlotSpec_MarkerEdgeColor: S.MarkerEdgeColor = v; break;
+        default: IM_ASSERT(false && "ImPlotSpec does not take a color"); return;
+        }
+        S.Specified |= 1 << spec;
+    }
+
+    template <typename Arg, typename... Args>
+    constexpr void BuildSpec(ImPlotSpecData &S, ImPlotSpec_ spec, const Arg &arg, const Args &...args)
+    {
+        BuildSpec(S, spec, arg);
+        BuildSpec(S, args...);
+    }
+
+    template <typename... Args>
+    constexpr ImPlotSpecData MakeSpec(const Args &...args)
+    {
+        ImPlotSpecData S;
+        BuildSpec(S, args...);
+        return S;
+    }
+
+    // Same effect as the SetNext*Style calls for the fields in the spec.
+    inline void SetNextItemSpec(const ImPlotSpecData &S)
+    {
+        ImPlotNextItemData &n = GImPlot->NextItemData;
+        if (S.Has(ImPlotSpec_LineWeight))
+            n.LineWeight = S.LineWeight;
+        if (S.Has(ImPlotSpec_LineColor))
+            n.Colors[ImPlotCol_Line] = S.LineColor;
+        if (S.Has(ImPlotSpec_FaceColor))
+            n.Colors[ImPlotCol_Fill] = S.FaceColor;
+        if (S.Has(ImPlotSpec_Marker))
+            n.Marker = S.Marker;
+        if (S.Has(ImPlotSpec_MarkerSize))
+            n.MarkerSize = S.MarkerSize;
+        if (S.Has(ImPlotSpec_MarkerFaceColor))
+            n.Colors[ImPlotCol_MarkerFill] = S.MarkerFaceColor;
+        if (S.Has(ImPlotSpec_MarkerEdgeColor))
+            n.Colors[ImPlotCol_MarkerOutline] = S.MarkerEdgeColor;
+    }
+
+    template <typename T>
+    inline void PlotLine(const char *label_id, const T *xs, const T *ys, int count, const ImPlotSpecData &S)
+    {
+        SetNextItemSpec(S);
+        PlotLine(label_id, xs, ys, count, 0, S.Offset, S.Stride > 0 ? S.Stride : (int)sizeof(T));
+    }
+
+    template <typename T, typename Arg, typename... Args>
+    inline void PlotLine(const char *label_id, const T *xs, const T *ys, int count, ImPlotSpec_ spec, const Arg &arg, const Args &...args)
+    {
+        PlotLine(label_id, xs, ys, count, MakeSpec(spec, arg, args...));
+    }
+
+    template <typename T>
+    inline void PlotScatter(const char *label_id, const T *xs, const T *ys, int count, const ImPlotSpecData &S)
+    {
+        SetNextItemSpec(S);
+        PlotScatter(label_id, xs, ys, count, 0, S.Offset, S.Stride > 0 ? S.Stride : (int)sizeof(T));
+    }
+
+    template <typename T, typename Arg, typename... Args>
+    inline void PlotScatter(const char *label_id, const T *xs, const T *ys, int count, ImPlotSpec_ spec, const Arg &arg, const Args &...args)
+    {
+        PlotScatter(label_id, xs, ys, count, MakeSpec(spec, arg, args...));
+    }
+}
@@ -0,0 +1,461 @@
+#pragma once
+
+#include "plot_line_inline.h"
+
+// Shared transform stage for the fast plot kernels. Typed input (arrays with
+// ImPlot's offset/stride semantics, or a getter) is transformed once into pixel
+// space SoA float buffers held in per-thread scratch, and the emitters below
+// turn those buffers into vertices for lines, scatter, shaded, bars and stairs.
+// Contiguous float and double data on linear axes goes through an AVX2 transform
+// when the CPU has it; a wrapped offset is handled as two contiguous slices.
+
+namespace ImPlot
+{
+    // Typed arrays as passed to PlotLine(xs, ys, count, flags, offset, stride).
+    template <typename T>
+    struct StageArrays
+    {
+        StageArrays(const T *xs, const T *ys, int count, int offset, int stride)
+            : Xs(xs), Ys(ys), Count(count), Offset(count > 0 ? (offset % count + count) % count : 0), Stride(stride) {}
+        double X(int i) const { return (double)*(const T *)((const char *)Xs + (size_t)Index(i) * Stride); }
+        double Y(int i) const { return (double)*(const T *)((const char *)Ys + (size_t)Index(i) * Stride); }
+        int Index(int i) const { return Offset + i < Count ? Offset + i : Offset + i - Count; }
+        const T *Xs;
+        const T *Ys;
+        int Count, Offset, Stride;
+    };
+
+    struct StageGetter
+    {
+        StageGetter(ImPlotGetter getter, void *data, int count) : Getter(getter), Data(data), Count(count) {}
+        double X(int i) const { return Getter(i, Data).x; }
+        double Y(int i) const { return Getter(i, Data).y; }
+        ImPlotGetter Getter;
+        void *Data;
+        int Count;
+    };
+
+    // pixel space points of the item being drawn
+    struct PlotStage
+    {
+        void Resize(int count)
+        {
+            Xs.resize(count);
+            Ys.resize(count);
+            Count = count;
+        }
+        ImVector<float> Xs, Ys;
+        int Count = 0;
+    };
+
+    // per thread scratch, reused by every staged item
+    inline PlotStage &GetPlotStage()
+    {
+        thread_local PlotStage stage;
+        return stage;
+    }
+
+    template <typename T>
+    static inline void TransformAxisScalar(const T *v, int count, float pix_min, double plt_min, float m, float *out)
+    {
+        for (int i = 0; i < count; ++i)
+            out[i] = pix_min + m * (float)((double)v[i] - plt_min);
+    }
+
+#ifdef IMPLOT_LINE_AVX2
+    template <typename T>
+    IMPLOT_AVX2_TARGET static void TransformAxisAvx2(const T *v, int count, float pix_min, double plt_min, float m, float *out)
+    {
+        const __m256 pix = _mm256_set1_ps(pix_min), scale = _mm256_set1_ps(m);
+        const LineOrigin8 origin(plt_min);
+        int i = 0;
+        for (; i + 8 <= count; i += 8)
+            _mm256_storeu_ps(out + i, _mm256_add_ps(pix, _mm256_mul_ps(scale, LoadLine8(v + i, origin))));
+        TransformAxisScalar(v + i, count - i, pix_min, plt_min, m, out + i);
+    }
+#endif
+
+    template <typename T>
+    static inline void TransformAxis(const T *v, int count, float pix_min, double plt_min, float m, float *out)
+    {
+        TransformAxisScalar(v, count, pix_min, plt_min, m, out);
+    }
+
+#ifdef IMPLOT_LINE_AVX2
+    static inline void TransformAxis(const float *v, int count, float pix_min, double plt_min, float m, float *out)
+    {
+        static const bool avx2 = CpuHasAvx2();
+        avx2 ? TransformAxisAvx2(v, count, pix_min, plt_min, m, out) : TransformAxisScalar(v, count, pix_min, plt_min, m, out);
+    }
+
+    static inline void TransformAxis(const double *v, int count, float pix_min, double plt_min, float m, float *out)
+    {
+        static const bool avx2 = CpuHasAvx2();
+        avx2 ? TransformAxisAvx2(v, count, pix_min, plt_min, m, out) : TransformAxisScalar(v, count, pix_min, plt_min, m, out);
+    }
+#endif
+
+    // one axis of contiguous data; the SIMD overloads above for linear axes
+    template <typename Scale, typename T>
+    static inline void TransformAxis(const Scale &f, const T *v, int count, float pix_min, double plt_min, float m, float *out)
+    {
+        if constexpr (Scale::Linear)
+            TransformAxis(v, count, pix_min, plt_min, m, out);
+        else
+            for (int i = 0; i < count; ++i)
+                out[i] = pix_min + m * (float)(f((double)v[i]) - plt_min);
+    }
+
+    template <typename T, typename Transform>
+    void StageTransform(const StageArrays<T> &in, const Transform &xf, PlotStage &stage)
+    {
+        stage.Resize(in.Count);
+        if (in.Stride == (int)sizeof(T))
+        {
+            // [Offset, Count) then [0, Offset)
+            const int head = in.Count - in.Offset;
+            TransformAxis(xf.FX, in.Xs + in.Offset, head, xf.MinXPix, xf.MinXPlt, xf.Mx, stage.Xs.Data);
+            TransformAxis(xf.FY, in.Ys + in.Offset, head, xf.MinYPix, xf.MinYPlt, xf.My, stage.Ys.Data);
+            TransformAxis(xf.FX, in.Xs, in.Offset, xf.MinXPix, xf.MinXPlt, xf.Mx, stage.Xs.Data + head);
+            TransformAxis(xf.FY, in.Ys, in.Offset, xf.MinYPix, xf.MinYPlt, xf.My, stage.Ys.Data + head);
+            return;
+        }
+        for (int i = 0; i < in.Count; ++i)
+        {
+            stage.Xs[i] = xf.X(in.X(i));
+            stage.Ys[i] = xf.Y(in.Y(i));
+        }
+    }
+
+    template <typename Transform>
+    void StageTransform(const StageGetter &in, const Transform &xf, PlotStage &stage)
+    {
+        stage.Resize(in.Count);
+        for (int i = 0; i < in.Count; ++i)
+        {
+            const ImPlotPoint p = in.Getter(i, in.Data);
+            stage.Xs[i] = xf.X(p.x);
+            stage.Ys[i] = xf.Y(p.y);
+        }
+    }
+
+    template <typename Input>
+    void StageFit(const Input &in)
+    {
+        for (int i = 0; i < in.Count; ++i)
+            FitPoint(ImPlotPoint(in.X(i), in.Y(i)));
+    }
+
+    static inline void PrimRect(ImDrawList &DrawList, float x0, float y0, float x1, float y1, const ImVec2 &uv, ImU32 col)
+    {
+        PrimLineQuad(DrawList, x0, y0, x1, y0, x1, y1, x0, y1, uv, col);
+    }
+
+    static inline void PrimTriangle(ImDrawList &DrawList, const ImVec2 &a, const ImVec2 &b, const ImVec2 &c, const ImVec2 &uv, ImU32 col)
+    {
+        DrawList._VtxWritePtr[0].pos = a;
+        DrawList._VtxWritePtr[0].uv = uv;
+        DrawList._VtxWritePtr[0].col = col;
+        DrawList._VtxWritePtr[1].pos = b;
+        DrawList._VtxWritePtr[1].uv = uv;
+        DrawList._VtxWritePtr[1].col = col;
+        DrawList._VtxWritePtr[2].pos = c;
+        DrawList._VtxWritePtr[2].uv = uv;
+        DrawList._VtxWritePtr[2].col = col;
+        DrawList._VtxWritePtr += 3;
+        DrawList._IdxWritePtr[0] = (ImDrawIdx)(DrawList._VtxCurrentIdx);
+        DrawList._IdxWritePtr[1] = (ImDrawIdx)(DrawList._VtxCurrentIdx + 1);
+        DrawList._IdxWritePtr[2] = (ImDrawIdx)(DrawList._VtxCurrentIdx + 2);
+        DrawList._IdxWritePtr += 3;
+        DrawList._VtxCurrentIdx += 3;
+    }
+
+    // false for non-finite ends too, which breaks lines at NaN gaps
+    static inline bool SegmentVisible(const ImRect &cull_rect, float x1, float y1, float x2, float y2)
+    {
+        return SegmentFinite(x1, y1, x2, y2) && ImMin(y1, y2) < cull_rect.Max.y && ImMax(y1, y2) > cull_rect.Min.y && ImMin(x1, x2) < cull_rect.Max.x && ImMax(x1, x2) > cull_rect.Min.x;
+    }
+
+    //-----------------------------------------------------------------------------
+    // Emitters, all reading a filled PlotStage
+    //-----------------------------------------------------------------------------
+
+    inline void EmitLine(ImDrawList &DrawList, const PlotStage &stage, const ImRect &cull_rect, const PrimLineProps &line, ImU32 col)
+    {
+        if (stage.Count < 2)
+            return;
+        PrimChunks(DrawList, stage.Count - 1, 6, 4, [&](unsigned int first, unsigned int cnt) {
+            for (unsigned int i = first; i < first + cnt; ++i)
+            {
+                const float x1 = stage.Xs[i], y1 = stage.Ys[i];
+                const float x2 = stage.Xs[i + 1], y2 = stage.Ys[i + 1];
+                if (SegmentVisible(cull_rect, x1, y1, x2, y2))
+                    PrimLine(DrawList, x1, y1, x2, y2, line, col);
+            }
+        });
+    }
+
+    // filled square markers of half size r
+    inline void EmitScatter(ImDrawList &DrawList, const PlotStage &stage, const ImRect &cull_rect, float r, const ImVec2 &uv, ImU32 col)
+    {
+        PrimChunks(DrawList, stage.Count, 6, 4, [&](unsigned int first, unsigned int cnt) {
+            for (unsigned int i = first; i < first + cnt; ++i)
+            {
+                const float x = stage.Xs[i], y = stage.Ys[i];
+                if (x + r > cull_rect.Min.x && x - r < cull_rect.Max.x && y + r > cull_rect.Min.y && y - r < cull_rect.Max.y)
+                    PrimRect(DrawList, x - r, y - r, x + r, y + r, uv, col);
+            }
+        });
+    }
+
+    // area between the line and y_ref (pixels); segments crossing y_ref are split
+    inline void EmitShaded(ImDrawList &DrawList, const PlotStage &stage, const ImRect &cull_rect, float y_ref, const ImVec2 &uv, ImU32 col)
+    {
+        if (stage.Count < 2)
+            return;
+        PrimChunks(DrawList, stage.Count - 1, 6, 6, [&](unsigned int first, unsigned int cnt) {
+            for (unsigned int i = first; i < first + cnt; ++i)
+            {
+                const float x1 = stage.Xs[i], y1 = stage.Ys[i];
+                const float x2 = stage.Xs[i + 1], y2 = stage.Ys[i + 1];
+                if (!SegmentFinite(x1, y1, x2, y2) || (!SegmentVisible(cull_rect, x1, ImMin(y1, y_ref), x2, ImMax(y2, y_ref)) && !SegmentVisible(cull_rect, x1, ImMax(y1, y_ref), x2, ImMin(y2, y_ref))))
+                    continue;
+                const float d1 = y1 - y_ref, d2 = y2 - y_ref;
+                if (d1 * d2 < 0)
+                {
+                    const ImVec2 xi(x1 + (x2 - x1) * d1 / (d1 - d2), y_ref);
+                    PrimTriangle(DrawList, ImVec2(x1, y1), xi, ImVec2(x1, y_ref), uv, col);
+                    PrimTriangle(DrawList, xi, ImVec2(x2, y2), ImVec2(x2, y_ref), uv, col);
+                }
+                else
+                {
+                    PrimLineQuad(DrawList, x1, y1, x2, y2, x2, y_ref, x1, y_ref, uv, col);
+                }
+            }
+        });
+    }
+
+    // bars of half width hw centered on x, from y_ref to y (pixels)
+    inline void EmitBars(ImDrawList &DrawList, const PlotStage &stage, const ImRect &cull_rect, float hw, float y_ref, const ImVec2 &uv, ImU32 col)
+    {
+        PrimChunks(DrawList, stage.Count, 6, 4, [&](unsigned int first, unsigned int cnt) {
+            for (unsigned int i = first; i < first + cnt; ++i)
+            {
+                const float x = stage.Xs[i], y = stage.Ys[i];
+                if (SegmentVisible(cull_rect, x - hw, y, x + hw, y_ref))
+                    PrimRect(DrawList, x - hw, ImMin(y, y_ref), x + hw, ImMax(y, y_ref), uv, col);
+            }
+        });
+    }
+
+    // post step: y holds until the next x, as PlotStairs
+    inline void EmitStairs(ImDrawList &DrawList, const PlotStage &stage, const ImRect &cull_rect, float weight, const ImVec2 &uv, ImU32 col)
+    {
+        if (stage.Count < 2)
+            return;
+        const float hw = weight * 0.5f;
+        PrimChunks(DrawList, stage.Count - 1, 12, 8, [&](unsigned int first, unsigned int cnt) {
+            for (unsigned int i = first; i < first + cnt; ++i)
+            {
+                const float x1 = stage.Xs[i], y1 = stage.Ys[i];
+                const float x2 = stage.Xs[i + 1], y2 = stage.Ys[i + 1];
+                if (!SegmentVisible(cull_rect, x1 - hw, y1 - hw, x2 + hw, y2 + hw))
+                    continue;
+                PrimRect(DrawList, ImMin(x1, x2) - hw, y1 - hw, ImMax(x1, x2) + hw, y1 + hw, uv, col);
+                PrimRect(DrawList, x2 - hw, ImMin(y1, y2), x2 + hw, ImMax(y1, y2), uv, col);
+            }
+        });
+    }
+
+    // false for NaN and infinity, as SegmentFinite
+    static inline bool ValueFinite(float v)
+    {
+        return SegmentFinite(v, v, v, v);
+    }
+
+    // Reduces pixel space points to the first, min, max and last point of every
+    // pixel column (M4). A line through the reduced points rasterizes the same as
+    // the full line, and at most 4 points per column are kept. Only the last
+    // point left of x_min and the first right of x_max are kept, so the segments
+    // crossing the edges still draw. A non-finite point ends its column and is
+    // kept as is, so the line breaks there. Returns false, leaving out
+    // incomplete, if the finite x are not monotonic increasing.
+    static inline bool DecimateM4(const float *xs, const float *ys, int count, float x_min, float x_max, ImVector<ImVec2> &out)
+    {
+        out.resize(0);
+        float x_prev = -FLT_MAX; // last finite x, for the monotonic check
+        int i = 0, left = -1;
+        for (; i < count; left = i++)
+        {
+            if (!ValueFinite(xs[i]))
+                continue;
+            if (xs[i] < x_prev)
+                return false;
+            if (xs[i] >= x_min)
+                break;
+            x_prev = xs[i];
+        }
+        if (left >= 0)
+            out.push_back(ImVec2(xs[left], ys[left]));
+        while (i < count)
+        {
+            const bool x_finite = ValueFinite(xs[i]);
+            if (x_finite && xs[i] < x_prev)
+                return false;
+            if (x_finite && xs[i] >= x_max)
+                break;
+            if (!x_finite || !ValueFinite(ys[i]))
+            {
+                out.push_back(ImVec2(xs[i], ys[i]));
+                x_prev = x_finite ? xs[i] : x_prev;
+                ++i;
+                continue;
+            }
+            const float col_end = ImMin(floorf(xs[i]) + 1, x_max);
+            const int first = i;
+            int imin = i, imax = i;
+            for (++i; i < count && ValueFinite(xs[i]) && ValueFinite(ys[i]) && xs[i] < col_end; ++i)
+            {
+                if (xs[i] < xs[i - 1])
+                    return false;
+                if (ys[i] < ys[imin])
+                    imin = i;
+                if (ys[i] > ys[imax])
+                    imax = i;
+            }
+            const int last = i - 1;
+            const int mid1 = ImMin(imin, imax), mid2 = ImMax(imin, imax);
+            out.push_back(ImVec2(xs[first], ys[first]));
+            if (mid1 != first)
+                out.push_back(ImVec2(xs[mid1], ys[mid1]));
+            if (mid2 != mid1 && mid2 != last)
+                out.push_back(ImVec2(xs[mid2], ys[mid2]));
+            if (last != first && last != mid1)
+                out.push_back(ImVec2(xs[last], ys[last]));
+            x_prev = xs[last];
+        }
+        if (i < count)
+            out.push_back(ImVec2(xs[i], ys[i]));
+        for (; i < count; ++i)
+        {
+            if (!ValueFinite(xs[i]))
+                continue;
+            if (xs[i] < x_prev)
+                return false;
+            x_prev = xs[i];
+        }
+        return true;
+    }
+
+    //-----------------------------------------------------------------------------
+    // Staged items
+    //-----------------------------------------------------------------------------
+
+    // BeginItem, fit, stage and emit(DrawList, item, transform, cull_rect, stage),
+    // with the transform specialized on the axis scales (DispatchPixelTransform).
+    template <typename Input, typename Emit>
+    void PlotStaged(const char *label_id, const Input &in, ImPlotCol col, Emit emit)
+    {
+        if (BeginItem(label_id, col))
+        {
+            if (FitThisFrame())
+                StageFit(in);
+            ImPlotPlot &plot = *GImPlot->CurrentPlot;
+            PlotStage &stage = GetPlotStage();
+            DispatchPixelTransform(plot, [&](const auto &xf) {
+                StageTransform(in, xf, stage);
+                emit(*GetPlotDrawList(), GetItemData(), xf, plot.PlotRect, stage);
+            });
+            EndItem();
+        }
+    }
+
+    template <typename Input>
+    void PlotLineStagedEx(const char *label_id, const Input &in)
+    {
+        PlotStaged(label_id, in, ImPlotCol_Line, [](ImDrawList &DrawList, const ImPlotNextItemData &s, const auto &, const ImRect &cull_rect, const PlotStage &stage) {
+            if (s.RenderLine)
+                EmitLine(DrawList, stage, cull_rect, GetPrimLineProps(DrawList, s.LineWeight), ImGui::GetColorU32(s.Colors[ImPlotCol_Line]));
+        });
+    }
+
+    template <typename T>
+    void PlotLineStaged(const char *label_id, const T *xs, const T *ys, int count, int offset = 0, int stride = sizeof(T))
+    {
+        PlotLineStagedEx(label_id, StageArrays<T>(xs, ys, count, offset, stride));
+    }
+
+    inline void PlotLineStagedG(const char *label_id, ImPlotGetter getter, void *data, int count)
+    {
+        PlotLineStagedEx(label_id, StageGetter(getter, data, count));
+    }
+
+    // PlotLineStaged with M4 decimation between the transform and emission, so
+    // vertices scale with the visible plot width rather than the data size.
+    // Data with non-monotonic x is drawn in full.
+    template <typename T>
+    void PlotLineM4(const char *label_id, const T *xs, const T *ys, int count, int offset = 0, int stride = sizeof(T))
+    {
+        PlotStaged(label_id, StageArrays<T>(xs, ys, count, offset, stride), ImPlotCol_Line, [](ImDrawList &DrawList, const ImPlotNextItemData &s, const auto &, const ImRect &cull_rect, const PlotStage &stage) {
+            thread_local ImVector<ImVec2> pts; // per thread, as GetPlotStage
+            if (!s.RenderLine)
+                return;
+            const ImU32 col = ImGui::GetColorU32(s.Colors[ImPlotCol_Line]);
+            const PrimLineProps line = GetPrimLineProps(DrawList, s.LineWeight);
+            if (DecimateM4(stage.Xs.Data, stage.Ys.Data, stage.Count, cull_rect.Min.x, cull_rect.Max.x, pts))
+                PrimPolyline(DrawList, pts.Data, pts.Size, cull_rect, line, col);
+            else
+                EmitLine(DrawList, stage, cull_rect, line, col);
+        });
+    }
+
+    template <typename T>
+    void PlotScatterStaged(const char *label_id, const T *xs, const T *ys, int count, int offset = 0, int stride = sizeof(T))
+    {
+        PlotStaged(label_id, StageArrays<T>(xs, ys, count, offset, stride), ImPlotCol_MarkerOutline, [](ImDrawList &DrawList, const ImPlotNextItemData &s, const auto &, const ImRect &cull_rect, const PlotStage &stage) {
+            if (s.RenderMarkerFill)
+                EmitScatter(DrawList, stage, cull_rect, s.MarkerSize, DrawList._Data->TexUvWhitePixel, ImGui::GetColorU32(s.Colors[ImPlotCol_MarkerFill]));
+        });
+    }
+
+    template <typename T>
+    void PlotShadedStaged(const char *label_id, const T *xs, const T *ys, int count, double yref = 0, int offset = 0, int stride = sizeof(T))
+    {
+        const StageArrays<T> in(xs, ys, count, offset, stride);
+        PlotStaged(label_id, in, ImPlotCol_Fill, [&](ImDrawList &DrawList, const ImPlotNextItemData &s, const auto &xf, const ImRect &cull_rect, const PlotStage &stage) {
+            if (FitThisFrame() && count > 0)
+                FitPoint(ImPlotPoint(in.X(0), yref));
+            if (s.RenderFill)
+                EmitShaded(DrawList, stage, cull_rect, xf.Y(yref), DrawList._Data->TexUvWhitePixel, ImGui::GetColorU32(s.Colors[ImPlotCol_Fill]));
+        });
+    }
+
+    // Half width in pixels of a bar centered on x. On a non-linear x axis bars
+    // are drawn with the width of the first one.
+    template <typename Transform>
+    static inline float BarHalfWidth(const Transform &xf, double x, double bar_size)
+    {
+        return 0.5f * ImFabs(xf.X(x + 0.5 * bar_size) - xf.X(x - 0.5 * bar_size));
+    }
+
+    template <typename T>
+    void PlotBarsStaged(const char *label_id, const T *xs, const T *ys, int count, double bar_size, int offset = 0, int stride = sizeof(T))
+    {
+        const StageArrays<T> in(xs, ys, count, offset, stride);
+        PlotStaged(label_id, in, ImPlotCol_Fill, [&](ImDrawList &DrawList, const ImPlotNextItemData &s, const auto &xf, const ImRect &cull_rect, const PlotStage &stage) {
+            if (FitThisFrame() && count > 0)
+                FitPoint(ImPlotPoint(in.X(0), 0));
+            if (s.RenderFill)
+                EmitBars(DrawList, stage, cull_rect, BarHalfWidth(xf, count > 0 ? in.X(0) : 0, bar_size), xf.Y(0), DrawList._Data->TexUvWhitePixel, ImGui::GetColorU32(s.Colors[ImPlotCol_Fill]));
+        });
+    }
+
+    template <typename T>
+    void PlotStairsStaged(const char *label_id, const T *xs, const T *ys, int count, int offset = 0, int stride = sizeof(T))
+    {
+        PlotStaged(label_id, StageArrays<T>(xs, ys, count, offset, stride), ImPlotCol_Line, [](ImDrawList &DrawList, const ImPlotNextItemData &s, const auto &, const ImRect &cull_rect, const PlotStage &stage) {
+            if (s.RenderLine)
+                EmitStairs(DrawList, stage, cull_rect, s.LineWeight, DrawList._Data->TexUvWhitePixel, ImGui::GetColorU32(s.Colors[ImPlotCol_Line]));
+        });
+    }
+}
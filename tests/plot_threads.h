@@ -0,0 +1,101 @@
+#pragma once
+
+#include <implot_internal.h>
+#include "ThreadPool.h"
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <thread>
+#include <vector>
+
+// Parallel loops for the fast plot kernels on the demos' ThreadPool
+// (3rdparty/ThreadPool.h). One pool is kept for the process, so splitting an
+// item across cores costs a wakeup rather than a thread creation every frame.
+
+namespace ImPlot
+{
+    // threads the kernels may use, including the calling one
+    inline int PlotThreadCount()
+    {
+        static const int count = (int)std::max(1u, std::thread::hardware_concurrency());
+        return count;
+    }
+
+    // caps the threads used by the kernels (0 for all), e.g. to measure scaling
+    inline int &PlotThreadLimit()
+    {
+        static int limit = 0;
+        return limit;
+    }
+
+    // PlotThreadCount() under PlotThreadLimit()
+    inline int PlotThreadsAllowed()
+    {
+        return PlotThreadLimit() > 0 ? ImMin(PlotThreadLimit(), PlotThreadCount()) : PlotThreadCount();
+    }
+
+    inline ThreadPool &GetPlotThreadPool()
+    {
+        static ThreadPool pool((size_t)PlotThreadCount() - 1);
+        return pool;
+    }
+
+    // true on a thread currently running parallel tasks
+    inline bool &InPlotThreadPool()
+    {
+        thread_local bool in_pool = false;
+        return in_pool;
+    }
+
+    // Runs fn(t) for every t in [0, tasks) and returns when all are done. Up to
+    // PlotThreadsAllowed() threads, the calling one included, take tasks in order
+    // until none are left, so tasks may outnumber threads. Calls from inside a
+    // task run inline: the pool's queue does not let a task wait on others.
+    template <typename F>
+    void ParallelRun(int tasks, F fn)
+    {
+        const int threads = ImMin(tasks, PlotThreadsAllowed());
+        if (threads <= 1 || InPlotThreadPool())
+        {
+            for (int t = 0; t < tasks; ++t)
+                fn(t);
+            return;
+        }
+        std::atomic<int> next(0);
+        auto work = [&]() {
+            const bool was_in_pool = InPlotThreadPool();
+            InPlotThreadPool() = true;
+            for (int t = next++; t < tasks; t = next++)
+                fn(t);
+            InPlotThreadPool() = was_in_pool;
+        };
+        std::vector<std::future<void>> helpers;
+        helpers.reserve(threads - 1);
+        for (int i = 1; i < threads; ++i)
+            helpers.push_back(GetPlotThreadPool().enqueue(work));
+        work();
+        for (auto &helper : helpers)
+            helper.wait();
+    }
+
+    // Number of chunks to split count items into, at least min_per_task each.
+    inline int ParallelTasks(int count, int min_per_task)
+    {
+        return ImClamp(count / min_per_task, 1, PlotThreadsAllowed());
+    }
+
+    // Runs fn(begin, end) over [0, count) split across the pool; small ranges
+    // run on the calling thread.
+    template <typename F>
+    void ParallelRanges(int count, F fn, int min_per_task = 1 << 16)
+    {
+        const int tasks = ParallelTasks(count, min_per_task);
+        if (tasks == 1)
+        {
+            fn(0, count);
+            return;
+        }
+        const int chunk = (count + tasks - 1) / tasks;
+        ParallelRun(tasks, [&](int t) { fn(ImMin(count, t * chunk), ImMin(count, (t + 1) * chunk)); });
+    }
+}